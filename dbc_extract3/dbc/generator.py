@@ -3683,6 +3683,18 @@ class SpellDataGenerator(DataGenerator):
                 index = [ e[1] for e in sorted(spelleffect_id_index, key = lambda e: e[0]) ],
                 array = 'spelleffect')
 
+        # Pseudo-runtime linking data for spell effects, array positions of the parent and trigger
+        # spell in spell data (0xffffffff if not present)
+        self._out.write('static constexpr std::array<std::array<uint32_t, 2>, {}> __{}_link_index {{ {{\n'.format(
+            len(effects), self.format_str('spelleffect') ))
+        for effect_id in effects:
+            effect = self.db('SpellEffect')[effect_id]
+            positions = [ spelldata_array_position.get(id, 0xffffffff)
+                    for id in (effect.id_parent, effect.trigger_spell) ]
+            self._out.write('  {{ {:>10}, {:>10} }},\n'.format(*positions))
+        self._out.write('} };\n')
+        self._out.write('#define {}_LINK_INDEX\n\n'.format(self.format_str('spelleffect').upper()))
+
         # Write out spell powers
         spellpower_id_index = []
 
@@ -26,6 +26,7 @@
 #include "sim/expressions.hpp"
 #include "sim/proc.hpp"
 #include "sim/sim.hpp"
+#include "util/chrono.hpp"
 #include "util/generic.hpp"
 #include "util/io.hpp"
 #include "util/util.hpp"
@@ -492,7 +493,13 @@ action_t::action_t( action_e ty, util::string_view token, player_t* p, const spe
     target_cache(),
     options(),
     state_cache(),
-    travel_events()
+    travel_events(),
+    state_live( 0 ),
+    state_peak( 0 ),
+    state_allocations( 0 ),
+    ready_cache_time( timespan_t::min() ),
+    ready_cache_versions(),
+    ready_cache_result( false )
 {
   assert( option.cycle_targets == 0 );
   assert( !name_str.empty() && "Abilities must have valid name_str entries!!" );
@@ -1643,13 +1650,13 @@ size_t action_t::available_targets( std::vector<player_t*>& tl ) const
 std::vector<player_t*>& action_t::target_list() const
 {
   // Check if target cache is still valid. If not, recalculate it
-  if ( !target_cache.is_valid )
+  if ( !target_cache.valid( sim->target_cache_epoch ) )
   {
     available_targets( target_cache.list );  // This grabs the full list of targets, which will also pickup various
                                              // awfulness that some classes have.. such as prismatic crystal.
     if ( sim->distance_targeting_enabled )
       check_distance_targeting( target_cache.list );
-    target_cache.is_valid = true;
+    target_cache.validate( sim->target_cache_epoch );
   }
 
   return target_cache.list;
@@ -1720,6 +1727,9 @@ block_result_e action_t::calculate_block_result( action_state_t* s ) const
 
 void action_t::execute()
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.execute++;
+
 #ifndef NDEBUG
   if ( !initialized )
   {
@@ -2318,7 +2328,18 @@ bool action_t::select_target()
 {
   if ( target_if_mode != TARGET_IF_NONE )
   {
-    player_t* potential_target = select_target_if_target();
+    player_t* potential_target;
+    if ( apl_profile.sample )
+    {
+      auto start = chrono::thread_clock::now();
+      potential_target = select_target_if_target();
+      apl_profile.target_if_time += chrono::elapsed_fp_seconds( start );
+      apl_profile.target_if_samples++;
+    }
+    else
+    {
+      potential_target = select_target_if_target();
+    }
     if ( potential_target )
     {
       // If the target changes, we need to regenerate the target cache to get the new primary target
@@ -2486,12 +2507,83 @@ bool action_t::action_ready()
   if ( option.moving != -1 && option.moving != ( player->is_moving() ? 1 : 0 ) )
     return false;
 
-  if ( if_expr && !if_expr->success() )
-    return false;
+  if ( if_expr )
+  {
+    if ( apl_profile.sample )
+    {
+      auto start   = chrono::thread_clock::now();
+      bool success = if_expr->success();
+      apl_profile.if_time += chrono::elapsed_fp_seconds( start );
+      apl_profile.if_samples++;
+      if ( !success )
+        return false;
+    }
+    else if ( !if_expr->success() )
+    {
+      return false;
+    }
+  }
 
   return true;
 }
 
+/// action_ready() as called from the APL with the profiler enabled. Every evaluation is counted,
+/// every apl_profile'th one also times the if= and target_if= expressions.
+bool action_t::profiled_action_ready()
+{
+  apl_profile.sample = apl_profile.evaluations++ % as<uint64_t>( sim->apl_profile ) == 0;
+  bool ready = action_ready();
+  apl_profile.sample = false;
+
+  if ( ready )
+    apl_profile.passes++;
+
+  return ready;
+}
+
+/// action_ready() as called from the APL with readiness memoization enabled. The result is reused
+/// while the sim time and all sim_t::apl_versions counters are unchanged, i.e. no cooldown, resource,
+/// buff, dot or target state changed, nothing executed, and no variable changed since.
+bool action_t::memoized_action_ready()
+{
+  // Skill based false positives/negatives roll the rng on every evaluation
+  bool cacheable = action_skill == 1 && player->current.skill_debuff == 0;
+  bool hit = cacheable && ready_cache_time == sim->current_time() && ready_cache_versions == sim->apl_versions;
+
+  sim->apl_ready_cache_lookups++;
+  if ( hit )
+  {
+    sim->apl_ready_cache_hits++;
+    if ( sim->apl_ready_cache < 2 )
+      return ready_cache_result;
+  }
+
+  auto versions = sim->apl_versions;
+  bool ready = sim->apl_profile ? profiled_action_ready() : action_ready();
+
+  if ( hit && ready != ready_cache_result && sim->apl_ready_cache_mismatches++ == 0 )
+  {
+    sim->error( "{} action {} readiness changed without an APL state change ({} -> {}).", *player, signature_str,
+                ready_cache_result, ready );
+  }
+
+  ready_cache_time = sim->current_time();
+  ready_cache_versions = versions;
+  ready_cache_result = ready;
+
+  return ready;
+}
+
+void action_t::apl_profile_t::merge( const apl_profile_t& other )
+{
+  evaluations += other.evaluations;
+  passes += other.passes;
+  if_samples += other.if_samples;
+  target_if_samples += other.target_if_samples;
+  if_time += other.if_time;
+  target_if_time += other.target_if_time;
+}
+
 // Properties that govern if the spell itself is executable, without considering any kind of user
 // options
 bool action_t::ready()
@@ -4323,7 +4415,10 @@ void action_t::trigger_dot( action_state_t* s )
   dot->max_stack      = dot_max_stack;
 
   if ( !dot->state )
+  {
     dot->state = get_state();
+    dot->mark_reset_dirty();
+  }
   dot->state->copy_state( s );
 
   if ( !dot->is_ticking() )
@@ -4911,7 +5006,7 @@ void action_t::acquire_target( retarget_source event, player_t* /* context */, p
 
 void action_t::activate()
 {
-  sim->target_non_sleeping_list.register_callback( [this]( player_t* ) { target_cache.is_valid = false; } );
+  // Enemy target list changes stale the target cache through sim_t::target_cache_epoch
 }
 
 // Change the target of the action, may require invalidation of target cache
@@ -5134,11 +5229,11 @@ player_t* action_t::select_target_if_target()
   std::vector<player_t*> master_list;
   if ( sim->distance_targeting_enabled )
   {
-    if ( !target_cache.is_valid )
+    if ( !target_cache.valid( sim->target_cache_epoch ) )
     {
       available_targets( target_cache.list );
       master_list = targets_in_range_list( target_cache.list );
-      target_cache.is_valid = true;
+      target_cache.validate( sim->target_cache_epoch );
     }
     else
     {
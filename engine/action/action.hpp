@@ -10,6 +10,7 @@
 #include "dbc/data_definitions.hh"
 #include "player/target_specific.hpp"
 #include "sc_enums.hpp"
+#include "sim/apl_versions.hpp"
 #include "sim/cooldown_waste_data.hpp"
 #include "util/format.hpp"
 #include "util/generic.hpp"
@@ -675,7 +676,14 @@ public:
   struct target_cache_t {
     std::vector< player_t* > list;
     bool is_valid;
-    target_cache_t() : is_valid( false ) {}
+    uint64_t epoch;
+    target_cache_t() : is_valid( false ), epoch( 0 ) {}
+
+    bool valid( uint64_t current_epoch ) const
+    { return is_valid && epoch == current_epoch; }
+
+    void validate( uint64_t current_epoch )
+    { is_valid = true; epoch = current_epoch; }
   } mutable target_cache;
 
 private:
@@ -683,6 +691,24 @@ private:
   action_state_t* state_cache;
   std::vector<travel_event_t*> travel_events;
 public:
+  // State allocation counters, states currently out of the state cache and their peak
+  unsigned state_live, state_peak;
+  unsigned state_allocations;
+  // APL line evaluation counters and sampled expression times, see sim_t::apl_profile
+  struct apl_profile_t
+  {
+    uint64_t evaluations = 0, passes = 0;
+    uint64_t if_samples = 0, target_if_samples = 0;
+    double if_time = 0, target_if_time = 0;
+    bool sample = false;
+
+    void merge( const apl_profile_t& other );
+  } apl_profile;
+  // Memoized action_ready() result, valid at the same time and sim_t::apl_versions
+  timespan_t ready_cache_time;
+  apl_versions_t ready_cache_versions;
+  bool ready_cache_result;
+
   action_t( action_e type, util::string_view token, player_t* p );
   action_t( action_e type, util::string_view token, player_t* p, const spell_data_t* s );
 
@@ -1110,6 +1136,9 @@ public:
   /// Is the action ready, as a combination of ability characteristics and user input? Main
   /// ntry-point when selecting something to do for an actor.
   virtual bool action_ready();
+
+  bool profiled_action_ready();
+  bool memoized_action_ready();
   /// Select a target to execute on
   virtual bool select_target();
   /// Target readiness state checking
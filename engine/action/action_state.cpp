@@ -9,6 +9,118 @@
 #include "sim/sim.hpp"
 #include <sstream>
 
+namespace
+{
+thread_local action_state_arena_t* current_arena = nullptr;
+}  // namespace
+
+action_state_arena_t::scope_t::scope_t( action_state_arena_t* arena ) : previous( current_arena )
+{
+  current_arena = arena;
+}
+
+action_state_arena_t::scope_t::~scope_t()
+{
+  current_arena = previous;
+}
+
+action_state_arena_t::action_state_arena_t() : free_list(), slab_cursor(), slab_end(), _stats(), released( false )
+{
+}
+
+void* action_state_arena_t::allocate( size_t size )
+{
+  size_t block = ( size + sizeof( header_t ) + GRANULE - 1 ) / GRANULE * GRANULE;
+
+  action_state_arena_t* arena = current_arena;
+  header_t* header            = nullptr;
+
+  // Large states, and states allocated outside of a running sim use the heap
+  if ( !arena || block > MAX_SIZE )
+  {
+    header = static_cast<header_t*>( ::operator new( block ) );
+    header->arena = nullptr;
+    return header + 1;
+  }
+
+  size_t size_class = block / GRANULE - 1;
+  if ( auto f = arena->free_list[ size_class ] )
+  {
+    arena->free_list[ size_class ] = f->next;
+    header = reinterpret_cast<header_t*>( f );
+  }
+  else
+  {
+    if ( arena->slab_end[ size_class ] - arena->slab_cursor[ size_class ] < static_cast<std::ptrdiff_t>( block ) )
+    {
+      arena->slabs.push_back( std::make_unique<char[]>( SLAB_SIZE ) );
+      arena->slab_cursor[ size_class ] = arena->slabs.back().get();
+      arena->slab_end[ size_class ]    = arena->slab_cursor[ size_class ] + SLAB_SIZE;
+      arena->_stats.slab_bytes += SLAB_SIZE;
+    }
+
+    header = reinterpret_cast<header_t*>( arena->slab_cursor[ size_class ] );
+    arena->slab_cursor[ size_class ] += block;
+  }
+
+  header->arena      = arena;
+  header->size_class = size_class;
+
+  arena->_stats.allocations++;
+  arena->_stats.live++;
+  arena->_stats.peak_live = std::max( arena->_stats.peak_live, arena->_stats.live );
+
+  return header + 1;
+}
+
+void action_state_arena_t::deallocate( void* p )
+{
+  if ( !p )
+    return;
+
+  auto header = static_cast<header_t*>( p ) - 1;
+  if ( !header->arena )
+  {
+    ::operator delete( header );
+    return;
+  }
+
+  header->arena->free( header );
+}
+
+void action_state_arena_t::free( header_t* header )
+{
+  auto f = reinterpret_cast<free_t*>( header );
+  f->next = free_list[ header->size_class ];
+  free_list[ header->size_class ] = f;
+
+  if ( --_stats.live == 0 && released )
+  {
+    delete this;
+  }
+}
+
+void action_state_arena_t::release()
+{
+  if ( current_arena == this )
+  {
+    current_arena = nullptr;
+  }
+
+  released = true;
+  if ( _stats.live == 0 )
+  {
+    delete this;
+  }
+}
+
+void action_state_arena_t::merge( const action_state_arena_t& other )
+{
+  _stats.allocations += other._stats.allocations;
+  _stats.peak_live = std::max( _stats.peak_live, other._stats.peak_live );
+  _stats.slab_bytes += other._stats.slab_bytes;
+}
+
 action_state_t* action_t::get_state( const action_state_t* other )
 {
   action_state_t* s = nullptr;
@@ -21,8 +133,11 @@ action_state_t* action_t::get_state( const action_state_t* other )
   else
   {
     s = new_state();
+    state_allocations++;
   }
 
+  state_peak = std::max( state_peak, ++state_live );
+
   s->action = this;
   if ( !other )
   {
@@ -46,6 +161,7 @@ void action_t::release_state( action_state_t* s )
   assert( s->action == this );
   s->next     = state_cache;
   state_cache = s;
+  state_live--;
 }
 
 // Initialize contains all variables that must be reset every time a new
@@ -5,9 +5,12 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <memory>
 #include <string>
 #include <iosfwd>
+#include <vector>
 #include "config.hpp"
 #include "util/generic.hpp"
 #include "sc_enums.hpp"
@@ -17,6 +20,74 @@
 struct action_t;
 struct player_t;
 
+// Per-sim slab storage of action states. States are allocated in 16 byte size classes from
+// contiguous, size class specific slabs, and recycled per size class. The arena is only used by
+// the thread that currently runs the owning sim, see action_state_arena_t::scope_t.
+class action_state_arena_t : private noncopyable
+{
+public:
+  static constexpr size_t GRANULE   = 16;
+  static constexpr size_t MAX_SIZE  = 1024;
+  static constexpr size_t SLAB_SIZE = 16384;
+
+  struct stats_t
+  {
+    size_t allocations = 0; // States allocated from the arena
+    size_t live        = 0; // States currently allocated
+    size_t peak_live   = 0; // Maximum number of states allocated at the same time
+    size_t slab_bytes  = 0; // Memory reserved for slabs
+  };
+
+  // Makes the arena current for the calling thread for the lifetime of the scope
+  class scope_t : private noncopyable
+  {
+    action_state_arena_t* previous;
+
+  public:
+    explicit scope_t( action_state_arena_t* arena );
+    ~scope_t();
+  };
+
+private:
+  static constexpr size_t N_CLASSES = MAX_SIZE / GRANULE;
+
+  // Precedes every state, identifies the arena and size class the memory is returned to
+  struct alignas( GRANULE ) header_t
+  {
+    action_state_arena_t* arena;
+    size_t                size_class;
+  };
+
+  struct free_t
+  {
+    free_t* next;
+  };
+
+  std::array<free_t*, N_CLASSES>       free_list;
+  std::array<char*, N_CLASSES>         slab_cursor;
+  std::array<char*, N_CLASSES>         slab_end;
+  std::vector<std::unique_ptr<char[]>> slabs;
+  stats_t                              _stats;
+  bool                                 released;
+
+  void free( header_t* );
+
+public:
+  action_state_arena_t();
+
+  static void* allocate( size_t size );
+  static void  deallocate( void* );
+
+  // Owner is done with the arena, it is destroyed once all of its states are freed
+  void release();
+
+  // Accumulate allocation statistics of another (thread) arena
+  void merge( const action_state_arena_t& other );
+
+  const stats_t& stats() const
+  { return _stats; }
+};
+
 struct action_state_t : private noncopyable
 {
   action_state_t* next;
@@ -68,6 +139,14 @@ struct action_state_t : private noncopyable
   action_state_t( action_t*, player_t* );
   virtual ~action_state_t() = default;
 
+  // All state objects, including class module derived ones, are allocated through the arena of the
+  // running sim
+  static void* operator new( std::size_t size )
+  { return action_state_arena_t::allocate( size ); }
+
+  static void operator delete( void* p )
+  { action_state_arena_t::deallocate( p ); }
+
   virtual void copy_state( const action_state_t* );
   virtual void initialize();
 
@@ -66,14 +66,19 @@ dot_t::dot_t( util::string_view n, player_t* t, player_t* s )
     current_tick(),
     max_stack(),
     name_str( n ),
-    internal_id( s->get_dot_id( n ) )
+    internal_id( s->get_dot_id( n ) ),
+    reset_dirty( false )
 {
+  mark_reset_dirty();
 }
 
 // dot_t::cancel ============================================================
 
 void dot_t::cancel()
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   if ( !ticking )
     return;
 
@@ -86,6 +91,9 @@ void dot_t::cancel()
 void dot_t::adjust_duration( timespan_t extra_seconds, timespan_t max_total_time, uint32_t state_flags,
                              bool count_as_refresh )
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   if ( !ticking )
     return;
   if ( extra_seconds == 0_ms )
@@ -178,13 +186,33 @@ void dot_t::reset()
     action_state_t::release( state );
 }
 
+void dot_t::mark_reset_dirty()
+{
+  if ( reset_dirty )
+    return;
+
+  reset_dirty = true;
+  target->dirty_dot_list.push_back( this );
+}
+
+bool dot_t::is_reset_clean() const
+{
+  return !ticking && !tick_event && !end_event && !state && stack == 0 && current_tick == 0 &&
+         current_duration == timespan_t::min();
+}
+
 /* Trigger a dot with given duration.
  * Main function to start/refresh a dot
  */
 void dot_t::trigger( timespan_t duration )
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   assert( duration > 0_ms && "Dot Trigger with duration <= 0 seconds." );
 
+  mark_reset_dirty();
+
   current_tick = 0;
   extra_time   = 0_ms;
 
@@ -200,6 +228,9 @@ void dot_t::trigger( timespan_t duration )
 
 void dot_t::decrement( int stacks = 1 )
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   if ( max_stack == 0 || stack <= 0 )
     return;
 
@@ -219,6 +250,9 @@ void dot_t::decrement( int stacks = 1 )
 
 void dot_t::increment(int stacks = 1)
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   if (max_stack == 0 || stack <= 0 || stack == max_stack)
     return;
 
@@ -264,6 +298,7 @@ void dot_t::copy( player_t* destination, dot_copy_e copy_type, action_t* copy_ac
   {
     target_state     = copy_action->get_state( state );
     other_dot->state = target_state;
+    other_dot->mark_reset_dirty();
   }
   else
   {
@@ -735,6 +770,9 @@ bool dot_t::channel_interrupt()
  */
 void dot_t::tick()
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   if ( current_action->channeled )
   {
     // If the ability has an interrupt or chain-based option enabled, we need to dynamically regen
@@ -771,6 +809,9 @@ void dot_t::tick()
  */
 void dot_t::last_tick()
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   sim.print_debug( "{} fades from {}", *this, *state->target );
 
   current_action->last_tick( this );
@@ -849,6 +890,9 @@ void dot_t::schedule_tick()
 
 void dot_t::start( timespan_t duration )
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   current_duration = duration;
 
   ticking = true;
@@ -872,6 +916,9 @@ void dot_t::start( timespan_t duration )
  */
 void dot_t::refresh( timespan_t duration )
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.target++;
+
   current_duration =
       current_action->calculate_dot_refresh_duration( this, duration );
 
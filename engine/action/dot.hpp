@@ -45,6 +45,7 @@ public:
   int max_stack;
   std::string name_str;
   int internal_id;
+  bool reset_dirty;  // Changed since the last reset, see player_t::dirty_dot_list
 
   dot_t(util::string_view n, player_t* target, player_t* source);
 
@@ -56,6 +57,8 @@ public:
   }
   void   refresh_duration(uint32_t state_flags = -1);
   void   reset();
+  void   mark_reset_dirty();
+  bool   is_reset_clean() const;
   void   cancel();
   void   trigger(timespan_t duration);
   void   decrement(int stacks);
@@ -721,6 +721,106 @@ double parse_effects_t::get_effect_value_full( const player_effect_t& i, bool be
   return eff_val;
 }
 
+namespace
+{
+void compile_effects( compiled_effects_t& table, const std::vector<player_effect_t>& effects, bool product )
+{
+  table.compiled = true;
+  table.source   = effects.data();
+  table.size     = effects.size();
+  table.constant = product ? 1.0 : 0.0;
+  table.groups.clear();
+  table.dynamic.clear();
+
+  for ( size_t i = 0; i < effects.size(); i++ )
+  {
+    const auto& e = effects[ i ];
+    if ( !e.simple )
+    {
+      table.dynamic.push_back( as<uint32_t>( i ) );
+    }
+    else if ( !e.buff )
+    {
+      table.constant = product ? table.constant * ( 1.0 + e.value ) : table.constant + e.value;
+    }
+    else
+    {
+      auto it = range::find_if( table.groups, [ &e ]( const compiled_effects_t::buff_group_t& g ) {
+        return g.buff == e.buff;
+      } );
+      if ( it == table.groups.end() )
+      {
+        table.groups.push_back( { e.buff, {} } );
+        it = table.groups.end() - 1;
+      }
+      it->values.push_back( e.value );
+    }
+  }
+}
+
+// Group result at the given stack, cached until the stack changes
+double buff_group_value( compiled_effects_t::buff_group_t& group, int stack, bool product )
+{
+  if ( stack != group.stack )
+  {
+    group.stack  = stack;
+    group.result = product ? 1.0 : 0.0;
+    for ( auto v : group.values )
+      group.result = product ? group.result * ( 1.0 + v * stack ) : group.result + v * stack;
+  }
+
+  return group.result;
+}
+
+// Stack of the group's buff. Benefit tracking samples buff_t::stack() once per entry, as evaluating the
+// entries one by one does, so the buff up/down counts stay the same.
+int buff_group_stack( const compiled_effects_t::buff_group_t& group, bool benefit )
+{
+  if ( !benefit )
+    return group.buff->check();
+
+  int stack = 0;
+  for ( size_t i = 0; i < group.values.size(); i++ )
+    stack = group.buff->stack();
+
+  return stack;
+}
+}  // namespace
+
+double parse_effects_t::get_effect_product( compiled_effects_t& table, const std::vector<player_effect_t>& effects,
+                                            bool benefit ) const
+{
+  if ( !table.compiled_for( effects ) )
+    compile_effects( table, effects, true );
+
+  double result = table.constant;
+
+  for ( auto& group : table.groups )
+    result *= buff_group_value( group, buff_group_stack( group, benefit ), true );
+
+  for ( auto idx : table.dynamic )
+    result *= 1.0 + get_effect_value_full( effects[ idx ], benefit );
+
+  return result;
+}
+
+double parse_effects_t::get_effect_sum( compiled_effects_t& table, const std::vector<player_effect_t>& effects,
+                                        bool benefit ) const
+{
+  if ( !table.compiled_for( effects ) )
+    compile_effects( table, effects, false );
+
+  double result = table.constant;
+
+  for ( auto& group : table.groups )
+    result += buff_group_value( group, buff_group_stack( group, benefit ), false );
+
+  for ( auto idx : table.dynamic )
+    result += get_effect_value_full( effects[ idx ], benefit );
+
+  return result;
+}
+
 double parse_effects_t::get_effect_value( const target_effect_t& i, actor_target_data_t* td ) const
 {
   if ( auto check = i.func( td ) )
@@ -775,8 +875,7 @@ double parse_player_effects_t::composite_damage_versatility() const
 {
   auto v = player_t::composite_damage_versatility();
 
-  for ( const auto& i : versatility_effects )
-    v += get_effect_value( i );
+  v += get_effect_sum( versatility_table, versatility_effects );
 
   return v;
 }
@@ -785,8 +884,7 @@ double parse_player_effects_t::composite_heal_versatility() const
 {
   auto v = player_t::composite_heal_versatility();
 
-  for ( const auto& i : versatility_effects )
-    v += get_effect_value( i );
+  v += get_effect_sum( versatility_table, versatility_effects );
 
   return v;
 }
@@ -827,8 +925,7 @@ double parse_player_effects_t::composite_attack_power_multiplier() const
 {
   auto apm = player_t::composite_attack_power_multiplier();
 
-  for ( const auto& i : attack_power_multiplier_effects )
-    apm *= 1.0 + get_effect_value( i );
+  apm *= get_effect_product( attack_power_multiplier_table, attack_power_multiplier_effects );
 
   return apm;
 }
@@ -837,8 +934,7 @@ double parse_player_effects_t::composite_melee_crit_chance() const
 {
   auto mcc = player_t::composite_melee_crit_chance();
 
-  for ( const auto& i : crit_chance_effects )
-    mcc += get_effect_value( i );
+  mcc += get_effect_sum( crit_chance_table, crit_chance_effects );
 
   return mcc;
 }
@@ -847,8 +943,7 @@ double parse_player_effects_t::composite_spell_crit_chance() const
 {
   auto scc = player_t::composite_spell_crit_chance();
 
-  for ( const auto& i : crit_chance_effects )
-    scc += get_effect_value( i );
+  scc += get_effect_sum( crit_chance_table, crit_chance_effects );
 
   return scc;
 }
@@ -857,8 +952,7 @@ double parse_player_effects_t::composite_leech() const
 {
   auto leech = player_t::composite_leech();
 
-  for ( const auto& i : leech_effects )
-    leech += get_effect_value( i );
+  leech += get_effect_sum( leech_table, leech_effects );
 
   return leech;
 }
@@ -867,8 +961,7 @@ double parse_player_effects_t::composite_melee_expertise( const weapon_t* ) cons
 {
   auto me = player_t::composite_melee_expertise( nullptr );
 
-  for ( const auto& i : expertise_effects )
-    me += get_effect_value( i );
+  me += get_effect_sum( expertise_table, expertise_effects );
 
   return me;
 }
@@ -877,8 +970,7 @@ double parse_player_effects_t::composite_crit_avoidance() const
 {
   auto ca = player_t::composite_crit_avoidance();
 
-  for ( const auto& i : crit_avoidance_effects )
-    ca += get_effect_value( i );
+  ca += get_effect_sum( crit_avoidance_table, crit_avoidance_effects );
 
   return ca;
 }
@@ -887,8 +979,7 @@ double parse_player_effects_t::composite_parry() const
 {
   auto parry = player_t::composite_parry();
 
-  for ( const auto& i : parry_effects )
-    parry += get_effect_value( i );
+  parry += get_effect_sum( parry_table, parry_effects );
 
   return parry;
 }
@@ -897,8 +988,7 @@ double parse_player_effects_t::composite_base_armor_multiplier() const
 {
   auto bam = player_t::composite_base_armor_multiplier();
 
-  for ( const auto& i : base_armor_multiplier_effects )
-    bam *= 1.0 + get_effect_value( i );
+  bam *= get_effect_product( base_armor_multiplier_table, base_armor_multiplier_effects );
 
   return bam;
 }
@@ -907,8 +997,7 @@ double parse_player_effects_t::composite_armor_multiplier() const
 {
   auto am = player_t::composite_armor_multiplier();
 
-  for ( const auto& i : armor_multiplier_effects )
-    am *= 1.0 + get_effect_value( i );
+  am *= get_effect_product( armor_multiplier_table, armor_multiplier_effects );
 
   return am;
 }
@@ -917,8 +1006,7 @@ double parse_player_effects_t::composite_melee_haste() const
 {
   auto mh = player_t::composite_melee_haste();
 
-  for ( const auto& i : haste_effects )
-    mh *= 1.0 / ( 1.0 + get_effect_value( i ) );
+  mh /= get_effect_product( haste_table, haste_effects );
 
   return mh;
 }
@@ -927,8 +1015,7 @@ double parse_player_effects_t::composite_spell_haste() const
 {
   auto sh = player_t::composite_spell_haste();
 
-  for ( const auto& i : haste_effects )
-    sh *= 1.0 / ( 1.0 + get_effect_value( i ) );
+  sh /= get_effect_product( haste_table, haste_effects );
 
   return sh;
 }
@@ -937,8 +1024,7 @@ double parse_player_effects_t::composite_mastery() const
 {
   auto m = player_t::composite_mastery();
 
-  for ( const auto& i : mastery_effects )
-    m += get_effect_value( i );
+  m += get_effect_sum( mastery_table, mastery_effects );
 
   return m;
 }
@@ -957,8 +1043,7 @@ double parse_player_effects_t::composite_dodge() const
 {
   auto dodge = player_t::composite_dodge();
 
-  for ( const auto& i : dodge_effects )
-    dodge += get_effect_value( i );
+  dodge += get_effect_sum( dodge_table, dodge_effects );
 
   return dodge;
 }
@@ -967,8 +1052,7 @@ double parse_player_effects_t::composite_player_absorb_multiplier( const action_
 {
   auto am = player_t::composite_player_absorb_multiplier( s );
 
-  for ( const auto& i : absorb_multiplier_effects )
-    am *= 1.0 + get_effect_value( i );
+  am *= get_effect_product( absorb_multiplier_table, absorb_multiplier_effects );
 
   return am;
 }
@@ -977,8 +1061,7 @@ double parse_player_effects_t::composite_player_healing_received_multiplier() co
 {
   auto hr = player_t::composite_player_healing_received_multiplier();
 
-  for ( const auto& i : healing_received_effects )
-    hr *= 1.0 + get_effect_value( i );
+  hr *= get_effect_product( healing_received_table, healing_received_effects );
 
   return hr;
 }
@@ -986,8 +1069,7 @@ double parse_player_effects_t::composite_player_healing_received_multiplier() co
 double parse_player_effects_t::composite_player_absorb_received_multiplier() const
 {
   auto ar = player_t::composite_player_absorb_received_multiplier();
-  for ( const auto& i : absorb_received_mult_effects )
-    ar *= 1.0 + get_effect_value( i );
+  ar *= get_effect_product( absorb_received_mult_table, absorb_received_mult_effects );
   return ar;
 }
 
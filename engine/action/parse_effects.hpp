@@ -96,6 +96,31 @@ struct player_effect_t
                           const std::function<std::string( double )>& ) const;
 };
 
+// Compiled form of a player_effect_t vector for the hot composite functions. Simple constant entries are
+// folded into one value, simple buff entries are grouped per buff with the group result cached until the
+// buff stack changes, and only full processing entries are evaluated one by one. Recompiled whenever the
+// source vector is resized or reallocated.
+struct compiled_effects_t
+{
+  struct buff_group_t
+  {
+    buff_t* buff;
+    std::vector<double> values;
+    int stack = -1;
+    double result = 0.0;
+  };
+
+  bool compiled = false;
+  const player_effect_t* source = nullptr;
+  size_t size = 0;
+  double constant = 0.0;
+  std::vector<buff_group_t> groups;
+  std::vector<uint32_t> dynamic;
+
+  bool compiled_for( const std::vector<player_effect_t>& v ) const
+  { return compiled && source == v.data() && size == v.size(); }
+};
+
 // effects dependent on target state
 struct target_effect_t
 {
@@ -700,6 +725,9 @@ public:
 
   double get_effect_value( const player_effect_t&, bool benefit = false ) const;
   double get_effect_value_full( const player_effect_t&, bool benefit ) const;
+  // Product of ( 1 + value ) and sum of values over an effect vector, through its compiled table
+  double get_effect_product( compiled_effects_t&, const std::vector<player_effect_t>&, bool benefit = false ) const;
+  double get_effect_sum( compiled_effects_t&, const std::vector<player_effect_t>&, bool benefit = false ) const;
   double get_effect_value( const target_effect_t&, actor_target_data_t* ) const;
 
   virtual bool can_force( const spelleffect_data_t& ) const { return true; }
@@ -732,6 +760,11 @@ struct parse_player_effects_t : public player_t, public parse_effects_t
   std::vector<target_effect_t> target_multiplier_effects;
   std::vector<target_effect_t> target_pet_multiplier_effects;
 
+  mutable compiled_effects_t attack_power_multiplier_table, crit_chance_table, leech_table, expertise_table,
+      crit_avoidance_table, parry_table, base_armor_multiplier_table, armor_multiplier_table, haste_table,
+      mastery_table, dodge_table, versatility_table, absorb_multiplier_table, absorb_received_mult_table,
+      healing_received_table;
+
   // Cache Pairing, invalidate first of the pair when the second is invalidated
   std::vector<std::pair<cache_e, cache_e>> invalidate_with_parent;
 
@@ -833,6 +866,10 @@ struct parse_action_base_t : public parse_effects_t
   std::vector<target_effect_t> target_crit_chance_effects;
   std::vector<target_effect_t> target_crit_bonus_effects;
 
+  mutable compiled_effects_t ta_multiplier_table, da_multiplier_table, execute_time_table, flat_execute_time_table,
+      gcd_table, dot_duration_table, flat_dot_duration_table, tick_time_table, flat_tick_time_table, cost_table,
+      flat_cost_table, crit_chance_table, crit_chance_multiplier_table, crit_bonus_table;
+
 private:
   action_t* _action;
 
@@ -981,8 +1018,7 @@ public:
   {
     auto c = BASE::cost_flat_modifier();
 
-    for ( const auto& i : flat_cost_effects )
-      c += get_effect_value( i );
+    c += get_effect_sum( flat_cost_table, flat_cost_effects );
 
     return c;
   }
@@ -991,8 +1027,7 @@ public:
   {
     auto c = BASE::cost_pct_multiplier();
 
-    for ( const auto& i : cost_effects )
-      c *= 1.0 + get_effect_value( i );
+    c *= get_effect_product( cost_table, cost_effects );
 
     return c;
   }
@@ -1001,8 +1036,7 @@ public:
   {
     auto ta = BASE::composite_ta_multiplier( s );
 
-    for ( const auto& i : ta_multiplier_effects )
-      ta *= 1.0 + get_effect_value( i, true );
+    ta *= get_effect_product( ta_multiplier_table, ta_multiplier_effects, true );
 
     return ta;
   }
@@ -1011,8 +1045,7 @@ public:
   {
     auto da = BASE::composite_da_multiplier( s );
 
-    for ( const auto& i : da_multiplier_effects )
-      da *= 1.0 + get_effect_value( i, true );
+    da *= get_effect_product( da_multiplier_table, da_multiplier_effects, true );
 
     return da;
   }
@@ -1021,8 +1054,7 @@ public:
   {
     auto cc = BASE::composite_crit_chance();
 
-    for ( const auto& i : crit_chance_effects )
-      cc += get_effect_value( i );
+    cc += get_effect_sum( crit_chance_table, crit_chance_effects );
 
     return cc;
   }
@@ -1031,8 +1063,7 @@ public:
   {
     auto ccm = BASE::composite_crit_chance_multiplier();
 
-    for ( const auto& i : crit_chance_multiplier_effects )
-      ccm *= 1.0 + get_effect_value( i );
+    ccm *= get_effect_product( crit_chance_multiplier_table, crit_chance_multiplier_effects );
 
     return ccm;
   }
@@ -1041,8 +1072,7 @@ public:
   {
     auto cd = BASE::composite_crit_damage_bonus_multiplier();
 
-    for ( const auto& i : crit_bonus_effects )
-      cd *= 1.0 + get_effect_value( i, true );
+    cd *= get_effect_product( crit_bonus_table, crit_bonus_effects, true );
 
     return cd;
   }
@@ -1051,8 +1081,7 @@ public:
   {
     auto mul = BASE::execute_time_pct_multiplier();
 
-    for ( const auto& i : execute_time_effects )
-      mul *= 1.0 + get_effect_value( i, true );
+    mul *= get_effect_product( execute_time_table, execute_time_effects, true );
 
     return mul;
   }
@@ -1061,8 +1090,7 @@ public:
   {
     double add = 0.0;
 
-    for ( const auto& i : flat_execute_time_effects )
-      add += get_effect_value( i, true );
+    add += get_effect_sum( flat_execute_time_table, flat_execute_time_effects, true );
 
     return BASE::execute_time_flat_modifier() + timespan_t::from_millis( add );
   }
@@ -1071,8 +1099,7 @@ public:
   {
     auto mul = BASE::dot_duration_pct_multiplier( s );
 
-    for ( const auto& i : dot_duration_effects )
-      mul *= 1.0 + get_effect_value( i );
+    mul *= get_effect_product( dot_duration_table, dot_duration_effects );
 
     return mul;
   }
@@ -1081,8 +1108,7 @@ public:
   {
     double add = 0.0;
 
-    for ( const auto& i : flat_dot_duration_effects )
-      add += get_effect_value( i );
+    add += get_effect_sum( flat_dot_duration_table, flat_dot_duration_effects );
 
     return BASE::dot_duration_flat_modifier( s ) + timespan_t::from_millis( add );
   }
@@ -1093,8 +1119,7 @@ public:
     if ( g <= 0_ms )
       return 0_ms;
 
-    for ( const auto& i : gcd_effects )
-      g *= 1.0 + get_effect_value( i );
+    g *= get_effect_product( gcd_table, gcd_effects );
 
     return std::max( BASE::min_gcd, g );
   }
@@ -1103,8 +1128,7 @@ public:
   {
     auto mul = BASE::tick_time_pct_multiplier( s );
 
-    for ( const auto& i : tick_time_effects )
-      mul *= 1.0 + get_effect_value( i );
+    mul *= get_effect_product( tick_time_table, tick_time_effects );
 
     return mul;
   }
@@ -1113,8 +1137,7 @@ public:
   {
     double add = 0.0;
 
-    for ( const auto& i : flat_tick_time_effects )
-      add += get_effect_value( i );
+    add += get_effect_sum( flat_tick_time_table, flat_tick_time_effects );
 
     return BASE::tick_time_flat_modifier( s ) + timespan_t::from_millis( add );
   }
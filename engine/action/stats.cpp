@@ -49,6 +49,14 @@ stats_t::stats_t( util::string_view n, player_t* p ) :
   scaling( nullptr ),
   timeline_amount( nullptr )
 {
+  if ( sim.compact_statistics )
+  {
+    actual_amount.change_compact( true );
+    total_amount.change_compact( true );
+    portion_aps.change_compact( true );
+    portion_apse.change_compact( true );
+  }
+
   int size = std::min( sim.iterations, 10000 );
   actual_amount.reserve( size );
   total_amount.reserve( size );
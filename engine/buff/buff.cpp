@@ -23,6 +23,7 @@
 #include "util/rng.hpp"
 
 #include <sstream>
+#include <typeinfo>
 #include <utility>
 
 namespace
@@ -34,10 +35,12 @@ struct buff_expr_t : public expr_t
   action_t* action;
   buff_t* static_buff;
   target_specific_t<buff_t> specific_buff;
+  // Typed opcode for static buff expressions, see expression::program_t
+  expression::opcode_e opcode;
 
   buff_expr_t( util::string_view n, util::string_view bn, action_t* a, buff_t* b )
     : expr_t( get_full_expression_name( n, bn ) ), buff_name( bn ), action( a ),
-    static_buff( b ), specific_buff( false )
+    static_buff( b ), specific_buff( false ), opcode( expression::OP_CALL )
   {
   }
 
@@ -95,6 +98,14 @@ struct buff_expr_t : public expr_t
   {
     return buff()->s_data != spell_data_t::nil() && !buff()->s_data->ok();
   }
+
+  void compile( expression::program_t& program ) override
+  {
+    if ( static_buff && opcode != expression::OP_CALL )
+      program.leaf( opcode, static_buff );
+    else
+      program.call( this );
+  }
 };
 
 template <typename Fn>
@@ -369,13 +380,15 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
   }
   else if ( type == "remains" )
   {
-    return make_const_buff_expr( "buff_remains",
+    auto expr = make_const_buff_expr( "buff_remains",
       []( buff_t* buff ) {
         return buff->remains();
       },
       []( buff_t* buff ) {
         return buff->default_chance == 0;
       } );
+    expr->opcode = expression::OP_BUFF_REMAINS;
+    return expr;
   }
   else if ( type == "tick_time" )
   {
@@ -403,7 +416,7 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
   }
   else if ( type == "up" )
   {
-    return make_const_buff_expr( "buff_up",
+    auto expr = make_const_buff_expr( "buff_up",
       []( buff_t* buff ) {
         return buff->check() > 0;
       },
@@ -411,26 +424,32 @@ std::unique_ptr<expr_t> create_buff_expression( util::string_view buff_name, uti
         assert( buff->check() == 0 || buff->default_chance != 0);
         return buff->default_chance == 0;
       } );
+    expr->opcode = expression::OP_BUFF_UP;
+    return expr;
   }
   else if ( type == "down" )
   {
-    return make_const_buff_expr( "buff_down",
+    auto expr = make_const_buff_expr( "buff_down",
       []( buff_t* buff ) {
         return buff->check() <= 0;
       },
       []( buff_t* buff ) {
         return buff->default_chance == 0;
       } );
+    expr->opcode = expression::OP_BUFF_DOWN;
+    return expr;
   }
   else if ( type == "stack" )
   {
-    return make_const_buff_expr( "buff_stack",
+    auto expr = make_const_buff_expr( "buff_stack",
       []( buff_t* buff ) {
         return buff->check();
       },
       []( buff_t* buff ) {
         return buff->default_chance == 0;
       } );
+    expr->opcode = expression::OP_BUFF_STACK;
+    return expr;
   }
   else if ( type == "stack_pct" )
   {
@@ -680,7 +699,9 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
     start_intervals(),
     trigger_intervals(),
     duration_lengths(),
-    change_regen_rate( false )
+    change_regen_rate( false ),
+    reset_dirty( false ),
+    reset_tracked( -1 )
 {
   if ( source )  // Player Buffs
   {
@@ -697,6 +718,8 @@ buff_t::buff_t( sim_t* sim, player_t* target, player_t* source, util::string_vie
     cooldown = sim->get_cooldown( "buff_" + name_str );
   }
 
+  mark_reset_dirty();
+
   constant = ( constant_behavior == buff_constant_behavior::ALWAYS_CONSTANT );
 
   // Set Buff duration
@@ -851,6 +874,8 @@ buff_t* buff_t::set_dynamic_time_duration_multiplier( double new_multiplier )
   if ( new_multiplier == dynamic_time_duration_multiplier )
     return this;
 
+  mark_reset_dirty();
+
   auto old_multiplier = dynamic_time_duration_multiplier;
   dynamic_time_duration_multiplier = new_multiplier;
 
@@ -2043,7 +2068,10 @@ bool buff_t::trigger( int stacks, double value, double chance, timespan_t durati
       d.value = value;
     }
     else
+    {
+      mark_reset_dirty();
       delay = make_event<buff_delay_t>( *sim, this, stacks, value, duration );
+    }
   }
   else
   {
@@ -2056,6 +2084,8 @@ bool buff_t::trigger( int stacks, double value, double chance, timespan_t durati
 
 void buff_t::execute( int stacks, double value, timespan_t duration )
 {
+  mark_reset_dirty();
+
   if ( value == DEFAULT_VALUE() && default_value != DEFAULT_VALUE() )
     value = default_value;
 
@@ -2123,6 +2153,9 @@ void buff_t::increment( int stacks, double value, timespan_t duration )
 
 void buff_t::decrement( int stacks, double value )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
   if ( overridden )
     return;
 
@@ -2169,6 +2202,9 @@ void buff_t::decrement( int stacks, double value )
 
 void buff_t::extend_duration( player_t* p, timespan_t extra_seconds )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
   if ( !check() )
   {
     return;
@@ -2268,6 +2304,11 @@ void buff_t::reschedule_tick( timespan_t delta )
 
 void buff_t::start( int stacks, double value, timespan_t duration )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
+  mark_reset_dirty();
+
   if ( _max_stack == 0 )
     return;
 
@@ -2377,6 +2418,9 @@ void buff_t::start( int stacks, double value, timespan_t duration )
 
 void buff_t::refresh( int stacks, double value, timespan_t duration )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
   if ( _max_stack == 0 )
     return;
 
@@ -2466,6 +2510,11 @@ void buff_t::refresh( int stacks, double value, timespan_t duration )
 
 void buff_t::bump( int stacks, double value )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
+  mark_reset_dirty();
+
   if ( _max_stack == 0 )
     return;
 
@@ -2605,6 +2654,9 @@ void buff_t::bump( int stacks, double value )
 
 void buff_t::override_buff( int stacks, double value )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
   if ( _max_stack == 0 )
     return;
 
@@ -2670,6 +2722,9 @@ void buff_t::expire( action_t* action, timespan_t d )
 
 void buff_t::expire( timespan_t d )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.buff++;
+
   if ( current_stack <= 0 )
   {
     assert( tick_event == nullptr );
@@ -2847,6 +2902,38 @@ void buff_t::reset()
   dynamic_time_duration_multiplier = 1.0;
 }
 
+void buff_t::mark_reset_dirty()
+{
+  if ( reset_dirty )
+    return;
+
+  reset_dirty = true;
+  if ( source )
+    player->dirty_buff_list.push_back( this );
+}
+
+bool buff_t::is_reset_tracked()
+{
+  if ( reset_tracked < 0 )
+  {
+    const auto& type = typeid( *this );
+    reset_tracked = type == typeid( buff_t ) || type == typeid( stat_buff_t ) || type == typeid( absorb_buff_t ) ||
+                    type == typeid( cost_reduction_buff_t ) || type == typeid( movement_buff_t ) ||
+                    type == typeid( damage_buff_t );
+  }
+
+  return reset_tracked > 0;
+}
+
+/// Does the buff hold the state reset() leaves behind?
+bool buff_t::is_reset_clean() const
+{
+  return current_stack == 0 && !delay && !expiration_delay && !tick_event && expiration.empty() &&
+         last_start == timespan_t::min() && last_trigger == timespan_t::min() &&
+         last_expire == timespan_t::min() && last_stack_change == timespan_t::min() &&
+         dynamic_time_duration_multiplier == 1.0;
+}
+
 void buff_t::merge( const buff_t& other )
 {
   start_intervals.merge( other.start_intervals );
@@ -283,6 +283,9 @@ public:
   virtual void expire_override( int /* expiration_stacks */, timespan_t /* remaining_duration */ ) {}
   virtual void predict();
   virtual void reset();
+  void mark_reset_dirty();
+  bool is_reset_tracked();
+  bool is_reset_clean() const;
   virtual void aura_gain();
   virtual void aura_loss();
   virtual void merge( const buff_t& other_buff );
@@ -360,6 +363,11 @@ public:
 
   bool change_regen_rate;
 
+  // Buff state changed since the last reset, see player_t::dirty_buff_list. Only engine buff types
+  // are tracked, buff subclasses may hold extra state that their reset() override clears.
+  bool reset_dirty;
+  int reset_tracked;
+
   buff_t* set_chance( double chance );
   buff_t* set_duration( timespan_t duration );
   buff_t* modify_duration( timespan_t duration );
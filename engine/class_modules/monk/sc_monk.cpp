@@ -4616,13 +4616,13 @@ struct jadefire_stomp_t : public monk_spell_t
   std::vector<player_t *> &target_list() const override
   {
     // Check if target cache is still valid. If not, recalculate it
-    if ( !target_cache.is_valid )
+    if ( !target_cache.valid( sim->target_cache_epoch ) )
     {
       available_targets( target_cache.list );  // This grabs the full list of targets, which will also pickup various
                                                // awfulness that some classes have.. such as prismatic crystal.
       if ( sim->distance_targeting_enabled )
         check_distance_targeting( target_cache.list );
-      target_cache.is_valid = true;
+      target_cache.validate( sim->target_cache_epoch );
     }
 
     if ( !target_cache.list.empty() )
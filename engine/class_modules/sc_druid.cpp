@@ -4913,7 +4913,7 @@ struct rake_t final : public use_fluid_form_t<CAT_FORM, trigger_call_of_the_elde
 
   std::vector<player_t*>& target_list() const override
   {
-    if ( !target_cache.is_valid )
+    if ( !target_cache.valid( sim->target_cache_epoch ) )
       bleed->target_cache.is_valid = false;
 
     auto& tl = base_t::target_list();
@@ -4907,10 +4907,10 @@ struct living_flame_t : public evoker_spell_t
     if ( p()->talent.pupil_of_alexstrasza.ok() )
     {
       // TODO: Auto handle dummy cleave values and damage effectiveness
-      if ( !damage->target_cache.is_valid )
+      if ( !damage->target_cache.valid( sim->target_cache_epoch ) )
       {
         damage->available_targets( damage->target_cache.list );
-        damage->target_cache.is_valid = true;
+        damage->target_cache.validate( sim->target_cache_epoch );
       }
 
       if ( damage->target_cache.list.size() > 1 )
@@ -7603,7 +7603,7 @@ struct wildfire_bomb_base_t: public hunter_spell_t
         // Dot applies to all of the same targets hit by the main explosion
         bomb_dot->target                    = target;
         bomb_dot->target_cache.list         = target_cache.list;
-        bomb_dot->target_cache.is_valid     = true;
+        bomb_dot->target_cache.validate( target_cache.epoch );
         bomb_dot->execute();
       }
 
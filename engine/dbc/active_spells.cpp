@@ -13,19 +13,34 @@
 
 namespace
 {
-const active_class_spell_t& __find_class( util::string_view name,
-                                          bool              ptr,
-                                          bool              tokenized,
-                                          player_e          class_,
-                                          specialization_e  spec )
+const char* class_spell_name( const active_class_spell_t& e )
+{
+  return e.name;
+}
+
+const char* pet_spell_name( const active_pet_spell_t& e )
+{
+  return e.name;
+}
+
+const dbc::name_index_t<active_class_spell_t> class_spell_name_index( class_spell_name, dbc::name_key_ci );
+const dbc::name_index_t<active_class_spell_t> class_spell_token_index( class_spell_name, dbc::name_key_tokenized );
+const dbc::name_index_t<active_pet_spell_t> pet_spell_name_index( pet_spell_name, dbc::name_key_ci );
+const dbc::name_index_t<active_pet_spell_t> pet_spell_token_index( pet_spell_name, dbc::name_key_tokenized );
+
+const active_class_spell_t& __find_class( util::string_view            name,
+                                          bool                         ptr,
+                                          bool                         tokenized,
+                                          player_e                     class_,
+                                          specialization_e             spec,
+                                          dbc::name_index_benchmark_t* benchmark )
 {
   std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
   unsigned spec_id = static_cast<unsigned>( spec );
 
-  const auto __data = active_class_spell_t::data( ptr );
-
-  auto it = range::find_if( __data,
+  auto entry = dbc::find_by_name( tokenized ? class_spell_token_index : class_spell_name_index,
+                                  tokenized ? name_str : dbc::name_key_ci( name_str ), ptr,
   [&name_str, tokenized, class_id, spec_id]( const active_class_spell_t& e ) {
     if ( class_id != 0 && e.class_id != class_id )
     {
@@ -39,27 +54,27 @@ const active_class_spell_t& __find_class( util::string_view name,
 
     auto str = tokenized ? util::tokenize_fn( e.name ) : e.name;
     return util::str_compare_ci( name_str, str );
-  } );
+  }, benchmark );
 
-  if ( it == __data.end() )
+  if ( !entry )
   {
     return active_class_spell_t::nil();
   }
 
-  return *it;
+  return *entry;
 }
 
-const active_pet_spell_t& __find_pet( util::string_view name,
-                                      bool              ptr,
-                                      bool              tokenized,
-                                      player_e          class_)
+const active_pet_spell_t& __find_pet( util::string_view            name,
+                                      bool                         ptr,
+                                      bool                         tokenized,
+                                      player_e                     class_,
+                                      dbc::name_index_benchmark_t* benchmark )
 {
   std::string name_str = tokenized ? util::tokenize_fn( name ) : std::string( name );
   unsigned class_id = util::class_id( class_ );
 
-  const auto __data = active_pet_spell_t::data( ptr );
-
-  auto it = range::find_if( __data,
+  auto entry = dbc::find_by_name( tokenized ? pet_spell_token_index : pet_spell_name_index,
+                                  tokenized ? name_str : dbc::name_key_ci( name_str ), ptr,
   [&name_str, tokenized, class_id]( const active_pet_spell_t& e ) {
     if ( class_id != 0 && e.owner_class_id != class_id )
     {
@@ -68,14 +83,14 @@ const active_pet_spell_t& __find_pet( util::string_view name,
 
     auto str = tokenized ? util::tokenize_fn( e.name ) : e.name;
     return util::str_compare_ci( name_str, str );
-  } );
+  }, benchmark );
 
-  if ( it == __data.end() )
+  if ( !entry )
   {
     return active_pet_spell_t::nil();
   }
 
-  return *it;
+  return *entry;
 }
 } // Namespace anonymous ends
 
@@ -85,27 +100,29 @@ util::span<const active_class_spell_t> active_class_spell_t::data( bool ptr )
 }
 
 const active_class_spell_t&
-active_class_spell_t::find( util::string_view name, bool ptr, bool tokenized )
+active_class_spell_t::find( util::string_view name, bool ptr, bool tokenized, dbc::name_index_benchmark_t* benchmark )
 {
-  return __find_class( name, ptr, tokenized, PLAYER_NONE, SPEC_NONE );
+  return __find_class( name, ptr, tokenized, PLAYER_NONE, SPEC_NONE, benchmark );
 }
 
 const active_class_spell_t&
-active_class_spell_t::find( util::string_view name,
-                            player_e          class_,
-                            bool              ptr,
-                            bool              tokenized )
+active_class_spell_t::find( util::string_view            name,
+                            player_e                     class_,
+                            bool                         ptr,
+                            bool                         tokenized,
+                            dbc::name_index_benchmark_t* benchmark )
 {
-  return __find_class( name, ptr, tokenized, class_, SPEC_NONE );
+  return __find_class( name, ptr, tokenized, class_, SPEC_NONE, benchmark );
 }
 
 const active_class_spell_t&
-active_class_spell_t::find( util::string_view name,
-                            specialization_e  spec,
-                            bool              ptr,
-                            bool              tokenized )
+active_class_spell_t::find( util::string_view            name,
+                            specialization_e             spec,
+                            bool                         ptr,
+                            bool                         tokenized,
+                            dbc::name_index_benchmark_t* benchmark )
 {
-  return __find_class( name, ptr, tokenized, PLAYER_NONE, spec );
+  return __find_class( name, ptr, tokenized, PLAYER_NONE, spec, benchmark );
 }
 
 util::span<const active_pet_spell_t> active_pet_spell_t::data( bool ptr )
@@ -114,17 +131,18 @@ util::span<const active_pet_spell_t> active_pet_spell_t::data( bool ptr )
 }
 
 const active_pet_spell_t&
-active_pet_spell_t::find( util::string_view name, bool ptr, bool tokenized )
+active_pet_spell_t::find( util::string_view name, bool ptr, bool tokenized, dbc::name_index_benchmark_t* benchmark )
 {
-  return __find_pet( name, ptr, tokenized, PLAYER_NONE );
+  return __find_pet( name, ptr, tokenized, PLAYER_NONE, benchmark );
 }
 
 const active_pet_spell_t&
-active_pet_spell_t::find( util::string_view name,
-                          player_e          class_,
-                          bool              ptr,
-                          bool              tokenized )
+active_pet_spell_t::find( util::string_view            name,
+                          player_e                     class_,
+                          bool                         ptr,
+                          bool                         tokenized,
+                          dbc::name_index_benchmark_t* benchmark )
 {
-  return __find_pet( name, ptr, tokenized, class_ );
+  return __find_pet( name, ptr, tokenized, class_, benchmark );
 }
 
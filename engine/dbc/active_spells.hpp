@@ -21,9 +21,12 @@ struct active_class_spell_t
   unsigned    override_spell_id;
   const char* name;
 
-  static const active_class_spell_t& find( util::string_view name, bool ptr, bool tokenized = false );
-  static const active_class_spell_t& find( util::string_view name, player_e class_, bool ptr, bool tokenized = false );
-  static const active_class_spell_t& find( util::string_view name, specialization_e spec, bool ptr, bool tokenized = false );
+  static const active_class_spell_t& find( util::string_view name, bool ptr, bool tokenized = false,
+                                           dbc::name_index_benchmark_t* benchmark = nullptr );
+  static const active_class_spell_t& find( util::string_view name, player_e class_, bool ptr, bool tokenized = false,
+                                           dbc::name_index_benchmark_t* benchmark = nullptr );
+  static const active_class_spell_t& find( util::string_view name, specialization_e spec, bool ptr, bool tokenized = false,
+                                           dbc::name_index_benchmark_t* benchmark = nullptr );
 
   static const active_class_spell_t& nil()
   { return dbc::nil<active_class_spell_t>; }
@@ -37,8 +40,10 @@ struct active_pet_spell_t
   unsigned    spell_id;
   const char* name;
 
-  static const active_pet_spell_t& find( util::string_view name, bool ptr, bool tokenized = false );
-  static const active_pet_spell_t& find( util::string_view name, player_e player_class_, bool ptr, bool tokenized = false );
+  static const active_pet_spell_t& find( util::string_view name, bool ptr, bool tokenized = false,
+                                         dbc::name_index_benchmark_t* benchmark = nullptr );
+  static const active_pet_spell_t& find( util::string_view name, player_e player_class_, bool ptr, bool tokenized = false,
+                                         dbc::name_index_benchmark_t* benchmark = nullptr );
 
   static const active_pet_spell_t& nil()
   { return dbc::nil<active_pet_spell_t>; }
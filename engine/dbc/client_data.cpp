@@ -1,8 +1,31 @@
 #include "config.hpp"
 
+#include "util/io.hpp"
 #include "util/util.hpp"
 
 #include "client_data.hpp"
+#include "item_bonus.hpp"
+#include "item_effect.hpp"
+
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#if defined( SC_NO_CLIENT_DATA_BLOB ) && defined( SC_EXTERNAL_ITEM_DATA_ONLY )
+#error "SC_EXTERNAL_ITEM_DATA_ONLY requires external client data support"
+#endif
+
+#if !defined( SC_NO_CLIENT_DATA_BLOB )
+#if defined( SC_WINDOWS )
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#endif
 
 #include "generated/client_data_version.inc"
 #if SC_USE_PTR == 1
@@ -90,3 +113,260 @@ int dbc::client_data_build( bool ptr )
 
   return util::to_int( __version.substr( pos + 1 ) );
 }
+
+// Name indices ==============================================================
+
+std::string dbc::name_key( util::string_view name )
+{
+  return std::string( name );
+}
+
+std::string dbc::name_key_ci( util::string_view name )
+{
+  std::string key( name );
+  util::tolower( key );
+  return key;
+}
+
+std::string dbc::name_key_tokenized( util::string_view name )
+{
+  return util::tokenize_fn( name );
+}
+
+// External client data blob =================================================
+
+namespace {
+
+/* Blob layout: a header, followed by header.table_count table entries, followed by the table data.
+ * Table data is stored as the in-memory records of the engine that wrote the blob, 16 byte aligned,
+ * so record sizes are validated on access.
+ */
+struct blob_header_t
+{
+  char     magic[ 4 ];
+  uint32_t format_version;
+  uint32_t table_count;
+  uint32_t build[ 2 ];
+  uint32_t reserved;
+};
+
+struct blob_table_t
+{
+  uint32_t table;
+  uint32_t ptr;
+  uint32_t record_size;
+  uint32_t record_count;
+  uint64_t offset;
+};
+
+constexpr char BLOB_MAGIC[ 4 ] = { 'S', 'C', 'C', 'D' };
+constexpr uint32_t BLOB_FORMAT_VERSION = 1;
+constexpr uint64_t BLOB_ALIGNMENT = 16;
+
+// Record sizes of the tables, indexed by dbc::client_data_table_e
+constexpr std::array<size_t, static_cast<size_t>( dbc::client_data_table_e::MAX )> BLOB_RECORD_SIZE = { {
+  0,
+  sizeof( item_bonus_entry_t ),
+  sizeof( item_effect_t ),
+  sizeof( uint32_t ),
+} };
+
+struct mapped_table_t
+{
+  const void* data = nullptr;
+  size_t record_size = 0;
+  size_t count = 0;
+};
+
+struct mapped_blob_t
+{
+  std::string path;
+  const blob_header_t* header = nullptr;
+  std::array<std::array<mapped_table_t, 2>, static_cast<size_t>( dbc::client_data_table_e::MAX )> tables;
+};
+
+mapped_blob_t mapped_blob;
+
+std::pair<const void*, size_t> map_file( const std::string& path )
+{
+#if defined( SC_NO_CLIENT_DATA_BLOB )
+  throw std::runtime_error( fmt::format( "Unable to map client data '{}', SimulationCraft has not been built "
+                                         "with client data blob support.", path ) );
+#elif defined( SC_WINDOWS )
+  HANDLE file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                             FILE_ATTRIBUTE_NORMAL, nullptr );
+  if ( file == INVALID_HANDLE_VALUE )
+    throw std::runtime_error( fmt::format( "Unable to open client data '{}'.", path ) );
+
+  LARGE_INTEGER size;
+  HANDLE mapping = nullptr;
+  if ( GetFileSizeEx( file, &size ) && size.QuadPart > 0 )
+    mapping = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+  CloseHandle( file );
+
+  const void* base = mapping ? MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 ) : nullptr;
+  if ( mapping )
+    CloseHandle( mapping );
+  if ( !base )
+    throw std::runtime_error( fmt::format( "Unable to map client data '{}'.", path ) );
+
+  return { base, static_cast<size_t>( size.QuadPart ) };
+#else
+  int fd = open( path.c_str(), O_RDONLY );
+  if ( fd == -1 )
+    throw std::runtime_error( fmt::format( "Unable to open client data '{}'.", path ) );
+
+  struct stat st;
+  void* base = MAP_FAILED;
+  if ( fstat( fd, &st ) == 0 && st.st_size > 0 )
+    base = mmap( nullptr, static_cast<size_t>( st.st_size ), PROT_READ, MAP_SHARED, fd, 0 );
+  close( fd );
+
+  if ( base == MAP_FAILED )
+    throw std::runtime_error( fmt::format( "Unable to map client data '{}'.", path ) );
+
+  return { base, static_cast<size_t>( st.st_size ) };
+#endif
+}
+
+template <typename T>
+void append_table( std::vector<blob_table_t>& tables, std::vector<util::span<const uint8_t>>& contents,
+                   dbc::client_data_table_e table, bool ptr, util::span<const T> data )
+{
+  tables.push_back( { static_cast<uint32_t>( table ), ptr, static_cast<uint32_t>( sizeof( T ) ),
+                      static_cast<uint32_t>( data.size() ), 0 } );
+  contents.emplace_back( reinterpret_cast<const uint8_t*>( data.data() ), data.size_bytes() );
+}
+
+} // namespace
+
+void dbc::map_client_data( const std::string& path )
+{
+  if ( mapped_blob.header )
+    throw std::runtime_error( fmt::format( "Client data '{}' is already mapped.", mapped_blob.path ) );
+
+  auto file = map_file( path );
+  auto base = static_cast<const uint8_t*>( file.first );
+  auto size = file.second;
+
+  auto header = reinterpret_cast<const blob_header_t*>( base );
+  if ( size < sizeof( blob_header_t ) || std::memcmp( header->magic, BLOB_MAGIC, sizeof( BLOB_MAGIC ) ) != 0 )
+    throw std::runtime_error( fmt::format( "Client data '{}' is not a SimulationCraft client data file.", path ) );
+
+  if ( header->format_version != BLOB_FORMAT_VERSION )
+    throw std::runtime_error( fmt::format( "Client data '{}' has format version {}, expected {}.", path,
+                                           header->format_version, BLOB_FORMAT_VERSION ) );
+
+  if ( size < sizeof( blob_header_t ) + header->table_count * sizeof( blob_table_t ) )
+    throw std::runtime_error( fmt::format( "Client data '{}' is truncated.", path ) );
+
+  decltype( mapped_blob.tables ) tables;
+  auto entries = reinterpret_cast<const blob_table_t*>( base + sizeof( blob_header_t ) );
+  for ( size_t i = 0; i < header->table_count; ++i )
+  {
+    const auto& entry = entries[ i ];
+    uint64_t length = uint64_t( entry.record_size ) * entry.record_count;
+    if ( entry.table == 0 || entry.table >= tables.size() || entry.ptr > 1 || entry.offset % BLOB_ALIGNMENT ||
+         entry.offset > size || length > size - entry.offset )
+      throw std::runtime_error( fmt::format( "Client data '{}' has an invalid table entry {}.", path, i ) );
+
+    if ( entry.record_size != BLOB_RECORD_SIZE[ entry.table ] )
+      throw std::runtime_error( fmt::format( "Client data '{}' table {} has record size {}, expected {}.", path,
+                                             entry.table, entry.record_size, BLOB_RECORD_SIZE[ entry.table ] ) );
+
+    tables[ entry.table ][ entry.ptr ] = { base + entry.offset, entry.record_size, entry.record_count };
+  }
+
+  // Id indices must describe the data table they index
+  for ( unsigned ptr = 0; ptr < 2; ++ptr )
+  {
+    const auto& data = tables[ static_cast<size_t>( client_data_table_e::ITEM_EFFECT ) ][ ptr ];
+    const auto& index = tables[ static_cast<size_t>( client_data_table_e::ITEM_EFFECT_ID_INDEX ) ][ ptr ];
+    if ( data.count != index.count )
+      throw std::runtime_error( fmt::format( "Client data '{}' has a mismatching item effect id index.", path ) );
+  }
+
+  mapped_blob.path = path;
+  mapped_blob.header = header;
+  mapped_blob.tables = tables;
+}
+
+void dbc::write_client_data( const std::string& path )
+{
+  std::vector<blob_table_t> tables;
+  std::vector<util::span<const uint8_t>> contents;
+  std::array<std::vector<uint32_t>, 2> item_effect_index;
+
+  for ( bool ptr : { false, true } )
+  {
+    if ( ptr && !SC_USE_PTR )
+      continue;
+
+    auto item_effects = item_effect_t::data( ptr );
+    auto& index = item_effect_index[ ptr ];
+    index.resize( item_effects.size() );
+    std::iota( index.begin(), index.end(), 0U );
+    std::stable_sort( index.begin(), index.end(), [ &item_effects ]( uint32_t lhs, uint32_t rhs ) {
+      return item_effects[ lhs ].id < item_effects[ rhs ].id;
+    } );
+
+    append_table( tables, contents, client_data_table_e::ITEM_BONUS, ptr, item_bonus_entry_t::data( ptr ) );
+    append_table( tables, contents, client_data_table_e::ITEM_EFFECT, ptr, item_effects );
+    append_table( tables, contents, client_data_table_e::ITEM_EFFECT_ID_INDEX, ptr,
+                  util::span<const uint32_t>( index ) );
+  }
+
+  blob_header_t header {};
+  std::memcpy( header.magic, BLOB_MAGIC, sizeof( BLOB_MAGIC ) );
+  header.format_version = BLOB_FORMAT_VERSION;
+  header.table_count = as<uint32_t>( tables.size() );
+  header.build[ 0 ] = as<uint32_t>( client_data_build( false ) );
+  header.build[ 1 ] = as<uint32_t>( client_data_build( SC_USE_PTR ) );
+
+  uint64_t offset = sizeof( blob_header_t ) + tables.size() * sizeof( blob_table_t );
+  for ( size_t i = 0; i < tables.size(); ++i )
+  {
+    offset = ( offset + BLOB_ALIGNMENT - 1 ) / BLOB_ALIGNMENT * BLOB_ALIGNMENT;
+    tables[ i ].offset = offset;
+    offset += contents[ i ].size();
+  }
+
+  io::cfile file( path, "wb" );
+  if ( !file )
+    throw std::runtime_error( fmt::format( "Unable to open client data output file '{}'.", path ) );
+
+  std::fwrite( &header, sizeof( header ), 1, file );
+  std::fwrite( tables.data(), sizeof( blob_table_t ), tables.size(), file );
+  uint64_t position = sizeof( blob_header_t ) + tables.size() * sizeof( blob_table_t );
+  for ( size_t i = 0; i < tables.size(); ++i )
+  {
+    static constexpr uint8_t padding[ BLOB_ALIGNMENT ] = {};
+    std::fwrite( padding, 1, tables[ i ].offset - position, file );
+    std::fwrite( contents[ i ].data(), 1, contents[ i ].size(), file );
+    position = tables[ i ].offset + contents[ i ].size();
+  }
+
+  if ( std::ferror( file ) )
+    throw std::runtime_error( fmt::format( "Unable to write client data output file '{}'.", path ) );
+}
+
+std::string dbc::mapped_client_data_str( bool ptr )
+{
+  if ( !mapped_blob.header )
+    return {};
+
+  return fmt::format( "{} (build {})", mapped_blob.path, mapped_blob.header->build[ SC_USE_PTR && ptr ] );
+}
+
+const void* dbc::mapped_client_data( client_data_table_e table, bool ptr, size_t record_size, size_t& count )
+{
+  const auto& entry = mapped_blob.tables[ static_cast<size_t>( table ) ][ SC_USE_PTR && ptr ];
+  if ( !entry.data )
+    return nullptr;
+
+  assert( entry.record_size == record_size );
+  (void)record_size;
+
+  count = entry.count;
+  return entry.data;
+}
@@ -8,11 +8,18 @@
 #include "config.hpp"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
+#include "util/chrono.hpp"
+#include "util/concurrency.hpp"
 #include "util/generic.hpp"
 #include "util/span.hpp"
+#include "util/string_view.hpp"
 
 namespace dbc
 {
@@ -117,6 +124,151 @@ int hotfix_build_version( bool ptr );
 // current client data.
 std::string hotfix_hash_str( bool ptr );
 
+// Name keys for name_index_t: exact, lower case ( util::str_compare_ci ) and tokenized
+std::string name_key( util::string_view name );
+std::string name_key_ci( util::string_view name );
+std::string name_key_tokenized( util::string_view name );
+
+// Lazily built hash index from a record name key to all records with that key, in table order. Built
+// separately for live and PTR data on the first lookup. Lookups take an already computed key.
+template <typename T>
+class name_index_t
+{
+public:
+  using name_fn_t = const char* ( * )( const T& );
+  using key_fn_t = std::string ( * )( util::string_view );
+
+  name_index_t( name_fn_t name, key_fn_t key ) : name_fn( name ), key_fn( key ) {}
+
+  util::span<const T* const> find( const std::string& key, bool ptr ) const
+  {
+    auto& index = indices[ SC_USE_PTR && ptr ];
+    if ( !index.built.load( std::memory_order_acquire ) )
+    {
+      AUTO_LOCK( index.mutex );
+      if ( !index.built.load( std::memory_order_relaxed ) )
+      {
+        for ( const T& record : T::data( ptr ) )
+        {
+          if ( const char* name = name_fn( record ) )
+            index.records[ key_fn( name ) ].push_back( &record );
+        }
+        index.built.store( true, std::memory_order_release );
+      }
+    }
+
+    auto it = index.records.find( key );
+    if ( it == index.records.end() )
+      return {};
+
+    return it->second;
+  }
+
+private:
+  struct index_t
+  {
+    std::atomic<bool> built { false };
+    mutex_t mutex;
+    std::unordered_map<std::string, std::vector<const T*>> records;
+  };
+
+  name_fn_t name_fn;
+  key_fn_t key_fn;
+  mutable std::array<index_t, 2> indices;
+};
+
+// Name index benchmark of a sim ( name_index_benchmark=1 ), handed to the lookups through
+// dbc_t::name_index_benchmark. Indexed name lookups are repeated with the linear scan they replace,
+// counting lookups and the time spent in each.
+struct name_index_benchmark_t
+{
+  uint64_t lookups = 0, mismatches = 0;
+  int64_t indexed_ns = 0, linear_ns = 0;
+
+  void merge( const name_index_benchmark_t& other )
+  {
+    lookups += other.lookups;
+    mismatches += other.mismatches;
+    indexed_ns += other.indexed_ns;
+    linear_ns += other.linear_ns;
+  }
+};
+
+template <typename Indexed, typename Linear>
+auto benchmark_name_lookup( name_index_benchmark_t* benchmark, Indexed&& indexed, Linear&& linear )
+    -> decltype( indexed() )
+{
+  if ( !benchmark )
+    return indexed();
+
+  auto start = chrono::thread_clock::now();
+  auto result = indexed();
+  auto indexed_time = chrono::elapsed( start );
+
+  start = chrono::thread_clock::now();
+  auto linear_result = linear();
+  auto linear_time = chrono::elapsed( start );
+
+  benchmark->lookups++;
+  benchmark->mismatches += result != linear_result;
+  benchmark->indexed_ns += indexed_time.count();
+  benchmark->linear_ns += linear_time.count();
+
+  return result;
+}
+
+// First record in table order that matches the predicate, looked up from the name index candidates
+// for the key. The predicate must only accept records whose name key equals the given key.
+template <typename T, typename Predicate>
+const T* find_by_name( const name_index_t<T>& index, const std::string& key, bool ptr, Predicate&& pred,
+                       name_index_benchmark_t* benchmark = nullptr )
+{
+  return benchmark_name_lookup(
+      benchmark,
+      [ &index, &key, ptr, &pred ]() -> const T* {
+        auto records = index.find( key, ptr );
+        auto it = range::find_if( records, [ &pred ]( const T* record ) { return pred( *record ); } );
+        return it != records.end() ? *it : nullptr;
+      },
+      [ ptr, &pred ]() -> const T* {
+        const auto __data = T::data( ptr );
+        auto it = range::find_if( __data, pred );
+        return it != __data.end() ? &*it : nullptr;
+      } );
+}
+
+// External client data blob. Pointer-free tables can be served from a versioned binary file that is
+// mapped read-only into memory ( SIMC_CLIENT_DATA environment variable ), instead of the generated
+// tables compiled into the binary. Accessors prefer the mapped table when one is present.
+enum class client_data_table_e : uint32_t
+{
+  ITEM_BONUS = 1,
+  ITEM_EFFECT,
+  ITEM_EFFECT_ID_INDEX,
+  MAX
+};
+
+void map_client_data( const std::string& path );
+void write_client_data( const std::string& path );
+std::string mapped_client_data_str( bool ptr );
+const void* mapped_client_data( client_data_table_e table, bool ptr, size_t record_size, size_t& count );
+
+template <typename T>
+util::span<const T> mapped_data( client_data_table_e table, bool ptr )
+{
+  size_t count = 0;
+  auto data = mapped_client_data( table, ptr, sizeof( T ), count );
+  return { static_cast<const T*>( data ), count };
+}
+
+// Runtime linking and indexing of PTR client data, performed once on first PTR data access
+void link_ptr_data();
+
+inline void init_ptr( bool ptr )
+{
+  if ( SC_USE_PTR && ptr )
+    link_ptr_data();
+}
 
 } // Namespace dbc ends
 
@@ -314,6 +314,8 @@ class dbc_t
 {
 public:
   bool ptr;
+  // Name lookup benchmark of the owning sim, see sim_t::name_index_benchmark
+  dbc::name_index_benchmark_t* name_index_benchmark = nullptr;
 
 private:
   using id_map_t = std::unordered_map<uint32_t, uint32_t>;
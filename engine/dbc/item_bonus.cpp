@@ -6,14 +6,24 @@
 
 #include "util/generic.hpp"
 
+#if !defined( SC_EXTERNAL_ITEM_DATA_ONLY )
 #include "generated/item_bonus.inc"
 #if SC_USE_PTR == 1
 #include "generated/item_bonus_ptr.inc"
 #endif
+#endif
 
 util::span<const item_bonus_entry_t> item_bonus_entry_t::data( bool ptr )
 {
+  auto mapped = dbc::mapped_data<item_bonus_entry_t>( dbc::client_data_table_e::ITEM_BONUS, ptr );
+#if defined( SC_EXTERNAL_ITEM_DATA_ONLY )
+  return mapped;
+#else
+  if ( !mapped.empty() )
+    return mapped;
+
   return SC_DBC_GET_DATA( __item_bonus_data, __ptr_item_bonus_data, ptr );
+#endif
 }
 
 util::span<const item_bonus_entry_t> item_bonus_entry_t::find( unsigned bonus_id, bool ptr )
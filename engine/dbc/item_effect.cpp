@@ -5,18 +5,36 @@
 
 #include "item_effect.hpp"
 
+#if !defined( SC_EXTERNAL_ITEM_DATA_ONLY )
 #include "generated/item_effect.inc"
 #if SC_USE_PTR == 1
 #include "generated/item_effect_ptr.inc"
 #endif
+#endif
 
 util::span<const item_effect_t> item_effect_t::data( bool ptr )
 {
+  auto mapped = dbc::mapped_data<item_effect_t>( dbc::client_data_table_e::ITEM_EFFECT, ptr );
+#if defined( SC_EXTERNAL_ITEM_DATA_ONLY )
+  return mapped;
+#else
+  if ( !mapped.empty() )
+    return mapped;
+
   return SC_DBC_GET_DATA( __item_effect_data, __ptr_item_effect_data, ptr );
+#endif
 }
 
 /* static */ const item_effect_t& item_effect_t::find( unsigned id, bool ptr )
 {
+  auto mapped_index = dbc::mapped_data<uint32_t>( dbc::client_data_table_e::ITEM_EFFECT_ID_INDEX, ptr );
+#if defined( SC_EXTERNAL_ITEM_DATA_ONLY )
+  return dbc::find_indexed( id, data( ptr ), mapped_index, &item_effect_t::id );
+#else
+  if ( !mapped_index.empty() )
+    return dbc::find_indexed( id, data( ptr ), mapped_index, &item_effect_t::id );
+
   const auto index = SC_DBC_GET_DATA( __item_effect_id_index, __ptr_item_effect_id_index, ptr );
   return dbc::find_indexed( id, data( ptr ), index, &item_effect_t::id );
+#endif
 }
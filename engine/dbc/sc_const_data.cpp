@@ -24,6 +24,11 @@
 
 #include "player/player.hpp"
 #include "item/item.hpp"
+#include "util/concurrency.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <stdexcept>
 
 namespace { // ANONYMOUS namespace ==========================================
 
@@ -50,6 +55,8 @@ public:
 
   util::span<const spell_data_t* const> affects_spells( V value, bool ptr ) const
   {
+    dbc::init_ptr( ptr );
+
     auto it = m_db[ ptr ].find( value );
 
     if ( it != m_db[ ptr ].end() )
@@ -62,6 +69,8 @@ public:
 
   util::span<const spelleffect_data_t* const> affected_by( V value, bool ptr ) const
   {
+    dbc::init_ptr( ptr );
+
     auto it = m_effects_db[ ptr ].find( value );
 
     if ( it != m_effects_db[ ptr ].end() )
@@ -207,6 +216,15 @@ static void generate_indices( bool ptr )
  */
 void dbc::init()
 {
+  // Map external client data before any of it is accessed
+  if ( const char* client_data = std::getenv( "SIMC_CLIENT_DATA" ) )
+    map_client_data( client_data );
+#if defined( SC_EXTERNAL_ITEM_DATA_ONLY )
+  else
+    throw std::runtime_error( "SimulationCraft has been built without item bonus and item effect data, "
+                              "set SIMC_CLIENT_DATA to a client data file." );
+#endif
+
   // Create id-indexes
   init_item_data();
 
@@ -215,19 +233,40 @@ void dbc::init()
   spelleffect_data_t::link( false );
   talent_data_t::link( false );
 
-  if ( SC_USE_PTR )
-  {
-    spell_data_t::link( true );
-    spelleffect_data_t::link( true );
-    talent_data_t::link( true );
-  }
-
   // Generate indices
   generate_indices( false );
-  if ( SC_USE_PTR )
-  {
-    generate_indices( true );
-  }
+
+  // PTR data is linked and indexed on first access, see dbc::link_ptr_data()
+}
+
+/* Link and index PTR data. Called from the PTR data accessors, so the link step itself reads PTR
+ * data through them; the thread doing the linking skips the call, other threads wait for it.
+ */
+void dbc::link_ptr_data()
+{
+#if SC_USE_PTR
+  static std::atomic<bool> linked { false };
+  static mutex_t link_mutex;
+  static thread_local bool linking = false;
+
+  if ( linked.load( std::memory_order_acquire ) || linking )
+    return;
+
+  AUTO_LOCK( link_mutex );
+  if ( linked.load( std::memory_order_relaxed ) )
+    return;
+
+  linking = true;
+
+  spell_data_t::link( true );
+  spelleffect_data_t::link( true );
+  talent_data_t::link( true );
+
+  generate_indices( true );
+
+  linking = false;
+  linked.store( true, std::memory_order_release );
+#endif
 }
 
 /* Validate gem color */
@@ -299,6 +338,7 @@ std::vector< const spell_data_t* > dbc_t::effect_affects_spells( unsigned family
   if ( family == 0 )
     return affected_spells;
 
+  dbc::init_ptr( ptr );
   const auto& index = class_family_index[ ptr ];
   if ( family >= index.size() )
     return affected_spells;
@@ -393,6 +433,7 @@ std::vector< const spelleffect_data_t* > dbc_t::effects_affecting_spell( const s
   if ( spell -> class_family() == 0 )
     return affecting_effects;
 
+  dbc::init_ptr( ptr );
   const auto& index = class_family_index[ ptr ];
   if ( spell -> class_family() >= index.size() )
     return affecting_effects;
@@ -1646,15 +1687,15 @@ unsigned dbc_t::talent_ability_id( player_e c, specialization_e spec, util::stri
   const talent_data_t* t;
   if ( name_tokenized )
   {
-    t = talent_data_t::find_tokenized( spell_name, spec, ptr );
+    t = talent_data_t::find_tokenized( spell_name, spec, ptr, name_index_benchmark );
     if ( ! t )
-      t = talent_data_t::find_tokenized( spell_name, SPEC_NONE, ptr );
+      t = talent_data_t::find_tokenized( spell_name, SPEC_NONE, ptr, name_index_benchmark );
   }
   else
   {
-    t = talent_data_t::find( spell_name, spec, ptr ); // first try finding with the given spec
+    t = talent_data_t::find( spell_name, spec, ptr, name_index_benchmark ); // first try finding with the given spec
     if ( !t )
-      t = talent_data_t::find( spell_name, SPEC_NONE, ptr ); // now with SPEC_NONE
+      t = talent_data_t::find( spell_name, SPEC_NONE, ptr, name_index_benchmark ); // now with SPEC_NONE
   }
 
   if ( t && t -> is_class( c ) && ! replaced_id( t -> spell_id() ) )
@@ -1673,7 +1714,7 @@ unsigned dbc_t::class_ability_id( player_e          c,
   const active_class_spell_t* active_spell = nullptr;
   if ( spec_id != SPEC_NONE )
   {
-    active_spell = &active_class_spell_t::find( spell_name, spec_id, ptr, name_tokenized );
+    active_spell = &active_class_spell_t::find( spell_name, spec_id, ptr, name_tokenized, name_index_benchmark );
 
     // Try to find in class-specific general spells
     if ( active_spell->spell_id == 0U )
@@ -1687,16 +1728,16 @@ unsigned dbc_t::class_ability_id( player_e          c,
       }
 
       active_spell = &active_class_spell_t::find( spell_name,
-          util::translate_class_id( class_idx ), ptr, name_tokenized );
+          util::translate_class_id( class_idx ), ptr, name_tokenized, name_index_benchmark );
     }
   }
   else if ( c != PLAYER_NONE )
   {
-    active_spell = &active_class_spell_t::find( spell_name, c, ptr, name_tokenized );
+    active_spell = &active_class_spell_t::find( spell_name, c, ptr, name_tokenized, name_index_benchmark );
   }
   else
   {
-    active_spell = &active_class_spell_t::find( spell_name, ptr, name_tokenized );
+    active_spell = &active_class_spell_t::find( spell_name, ptr, name_tokenized, name_index_benchmark );
   }
 
   if ( active_spell->spell_id == 0U )
@@ -1719,11 +1760,11 @@ unsigned dbc_t::pet_ability_id( player_e c, util::string_view name, bool tokeniz
   const active_pet_spell_t* active_spell = nullptr;
   if ( c != PLAYER_NONE )
   {
-    active_spell = &active_pet_spell_t::find( name, c, ptr, tokenized );
+    active_spell = &active_pet_spell_t::find( name, c, ptr, tokenized, name_index_benchmark );
   }
   else
   {
-    active_spell = &active_pet_spell_t::find( name, ptr, tokenized );
+    active_spell = &active_pet_spell_t::find( name, ptr, tokenized, name_index_benchmark );
   }
 
   if ( active_spell->spell_id == 0U )
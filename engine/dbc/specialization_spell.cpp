@@ -11,6 +11,18 @@
 #include "generated/specialization_spells_ptr.inc"
 #endif
 
+namespace
+{
+const char* specialization_spell_name( const specialization_spell_entry_t& e )
+{
+  return e.name;
+}
+
+const dbc::name_index_t<specialization_spell_entry_t> name_index( specialization_spell_name, dbc::name_key_ci );
+const dbc::name_index_t<specialization_spell_entry_t> token_index( specialization_spell_name,
+                                                                   dbc::name_key_tokenized );
+} // namespace
+
 util::span<const specialization_spell_entry_t> specialization_spell_entry_t::data( bool ptr )
 {
   return SC_DBC_GET_DATA( __specialization_spell_data, __ptr_specialization_spell_data, ptr );
@@ -23,8 +35,6 @@ specialization_spell_entry_t::find( util::string_view name,
                                     util::string_view desc,
                                     bool              tokenized )
 {
-  auto __data = data( ptr );
-
   std::string cmp_str;
   std::string desc_cmp_str;
   if ( tokenized )
@@ -35,7 +45,9 @@ specialization_spell_entry_t::find( util::string_view name,
     desc = desc_cmp_str;
   }
 
-  auto it = range::find_if( __data, [tokenized, spec, name, desc]( const auto& entry ) {
+  auto spell = dbc::find_by_name( tokenized ? token_index : name_index,
+                                  tokenized ? cmp_str : dbc::name_key_ci( name ), ptr,
+                                  [tokenized, spec, name, desc]( const auto& entry ) {
       if ( spec != SPEC_NONE && spec != entry.specialization_id )
       {
         return false;
@@ -78,9 +90,9 @@ specialization_spell_entry_t::find( util::string_view name,
       }
   } );
 
-  if ( it != __data.end() )
+  if ( spell )
   {
-    return *it;
+    return *spell;
   }
 
   return nil();
@@ -536,24 +536,51 @@ util::span<const spelleffect_data_t> spelleffect_data_t::data( bool ptr )
   return _data( ptr );
 }
 
+// Spell and trigger spell positions in spell data are precomputed by the data generator when the
+// generated data defines the link index, spells not present in the data have an out of range
+// position. Older generated data falls back to searching the spell data.
+#if defined( SPELLEFFECT_LINK_INDEX ) && ( SC_USE_PTR == 0 || defined( PTR_SPELLEFFECT_LINK_INDEX ) )
+#define SC_SPELLEFFECT_LINK_INDEX
+#endif
+
 void spelleffect_data_t::link( bool ptr )
 {
-  for ( spelleffect_data_t& ed : _data( ptr ) )
+  const auto effects = _data( ptr );
+#if defined( SC_SPELLEFFECT_LINK_INDEX )
+  const auto spells = spell_data_t::data( ptr );
+  const auto index = SC_DBC_GET_DATA( __spelleffect_link_index, __ptr_spelleffect_link_index, ptr );
+  assert( index.size() == effects.size() );
+
+  auto spell = [ &spells ]( uint32_t position ) {
+    return position < spells.size() ? &spells[ position ] : spell_data_t::nil();
+  };
+#endif
+
+  for ( size_t i = 0; i < effects.size(); ++i )
   {
+    spelleffect_data_t& ed = effects[ i ];
     if ( ed.id() == 0 )
     {
       ed._spell = ed._trigger_spell = spell_data_t::not_found();
     }
     else
     {
+#if defined( SC_SPELLEFFECT_LINK_INDEX )
+      ed._spell = spell( index[ i ][ 0 ] );
+      ed._trigger_spell = spell( index[ i ][ 1 ] );
+      assert( ed._spell == spell_data_t::find( ed.spell_id(), ptr ) );
+      assert( ed._trigger_spell == spell_data_t::find( ed.trigger_spell_id(), ptr ) );
+#else
       ed._spell = spell_data_t::find( ed.spell_id(), ptr );
       ed._trigger_spell = spell_data_t::find( ed.trigger_spell_id(), ptr );
+#endif
     }
   }
 }
 
 util::span<spelleffect_data_t> spelleffect_data_t::_data( bool ptr )
 {
+  dbc::init_ptr( ptr );
   return SC_DBC_GET_DATA( __spelleffect_data, __ptr_spelleffect_data, ptr );
 }
 
@@ -686,13 +713,20 @@ const spell_data_t* spell_data_t::find( unsigned spell_id, util::string_view con
   return p;
 }
 
+namespace
+{
+const char* spell_name( const spell_data_t& spell )
+{
+  return spell.name_cstr();
+}
+
+const dbc::name_index_t<spell_data_t> spell_name_index( spell_name, dbc::name_key );
+} // namespace
+
 const spell_data_t* spell_data_t::find( util::string_view name, bool ptr )
 {
-  const auto __data = data( ptr );
-  auto it = range::find( __data, name, &spell_data_t::name_cstr );
-  if ( it != __data.end() )
-    return &*it;
-  return nullptr;
+  return dbc::find_by_name( spell_name_index, dbc::name_key( name ), ptr,
+                            [ name ]( const spell_data_t& s ) { return name == s.name_cstr(); } );
 }
 
 const spelleffect_data_t& spell_data_t::find_spelleffect( const spell_data_t& spell, effect_type_t type,
@@ -759,6 +793,7 @@ void spell_data_t::link( bool ptr )
 
 util::span<spell_data_t> spell_data_t::_data( bool ptr )
 {
+  dbc::init_ptr( ptr );
   return SC_DBC_GET_DATA( __spell_data, __ptr_spell_data, ptr );
 }
 
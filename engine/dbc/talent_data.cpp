@@ -39,26 +39,33 @@ const talent_data_t* talent_data_t::find( unsigned id, util::string_view confirm
   return p;
 }
 
-const talent_data_t* talent_data_t::find( util::string_view name, specialization_e spec, bool ptr )
+namespace
 {
-  for ( const talent_data_t& td : data( ptr ) )
-  {
-    if ( td.specialization() == spec && name == td.name_cstr() )
-      return &td;
-  }
-  return nullptr;
+const char* talent_name( const talent_data_t& td )
+{
+  return td.name_cstr();
 }
 
-const talent_data_t* talent_data_t::find_tokenized( util::string_view name, specialization_e spec, bool ptr )
+const dbc::name_index_t<talent_data_t> talent_name_index( talent_name, dbc::name_key );
+const dbc::name_index_t<talent_data_t> talent_token_index( talent_name, dbc::name_key_tokenized );
+} // namespace
+
+const talent_data_t* talent_data_t::find( util::string_view name, specialization_e spec, bool ptr,
+                                          dbc::name_index_benchmark_t* benchmark )
 {
-  for ( const talent_data_t& td : data( ptr ) )
-  {
-    auto tokenized_name = util::tokenize_fn( td.name_cstr() );
-    if ( td.specialization() == spec && util::str_compare_ci( name, tokenized_name ) )
-      return &td;
-  }
+  return dbc::find_by_name( talent_name_index, dbc::name_key( name ), ptr, [ name, spec ]( const talent_data_t& td ) {
+    return td.specialization() == spec && name == td.name_cstr();
+  }, benchmark );
+}
 
-  return nullptr;
+// Tokenized talent names are lower case, so the case insensitive compare is a lookup of the lower case name
+const talent_data_t* talent_data_t::find_tokenized( util::string_view name, specialization_e spec, bool ptr,
+                                                    dbc::name_index_benchmark_t* benchmark )
+{
+  return dbc::find_by_name( talent_token_index, dbc::name_key_ci( name ), ptr, [ name, spec ]( const talent_data_t& td ) {
+    auto tokenized_name = util::tokenize_fn( td.name_cstr() );
+    return td.specialization() == spec && util::str_compare_ci( name, tokenized_name );
+  }, benchmark );
 }
 
 const talent_data_t* talent_data_t::find( player_e c, unsigned int row, unsigned int col, specialization_e spec, bool ptr )
@@ -103,6 +110,7 @@ void talent_data_t::link( bool ptr )
 
 util::span<talent_data_t> talent_data_t::_data( bool ptr )
 {
+  dbc::init_ptr( ptr );
   return SC_DBC_GET_DATA( __talent_data, __ptr_talent_data, ptr );
 }
 
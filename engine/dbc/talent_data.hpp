@@ -11,6 +11,10 @@
 #include "util/string_view.hpp"
 
 struct spell_data_t;
+namespace dbc
+{
+struct name_index_benchmark_t;
+}
 
 struct talent_data_t
 {
@@ -66,8 +70,10 @@ struct talent_data_t
   static const talent_data_t& nil();
   static const talent_data_t* find( unsigned, bool ptr = false );
   static const talent_data_t* find( unsigned, util::string_view confirmation, bool ptr = false );
-  static const talent_data_t* find( util::string_view name, specialization_e spec, bool ptr = false );
-  static const talent_data_t* find_tokenized( util::string_view name, specialization_e spec, bool ptr = false );
+  static const talent_data_t* find( util::string_view name, specialization_e spec, bool ptr = false,
+                                    dbc::name_index_benchmark_t* benchmark = nullptr );
+  static const talent_data_t* find_tokenized( util::string_view name, specialization_e spec, bool ptr = false,
+                                              dbc::name_index_benchmark_t* benchmark = nullptr );
   static const talent_data_t* find( player_e c, unsigned int row, unsigned int col, specialization_e spec, bool ptr = false );
   static util::span<const talent_data_t> data( bool ptr = false );
   static void link( bool ptr = false );
@@ -250,6 +250,10 @@ namespace js {
       v_.AddMember(rapidjson::StringRef("std_dev"), v.std_dev, d_.GetAllocator());
       v_.AddMember(rapidjson::StringRef("mean_variance"), v.mean_variance, d_.GetAllocator());
       v_.AddMember(rapidjson::StringRef("mean_std_dev"), v.mean_std_dev, d_.GetAllocator());
+      if (v.streaming)
+      {
+        v_.AddMember(rapidjson::StringRef("median_rank_error"), v.percentile_error(0.5), d_.GetAllocator());
+      }
     }
 
     return *this;
@@ -6083,6 +6083,9 @@ void player_t::merge( player_t& other )
     if ( action_list[ i ]->internal_id == other.action_list[ i ]->internal_id )
     {
       action_list[ i ]->total_executions += other.action_list[ i ]->total_executions;
+      action_list[ i ]->state_allocations += other.action_list[ i ]->state_allocations;
+      action_list[ i ]->state_peak = std::max( action_list[ i ]->state_peak, other.action_list[ i ]->state_peak );
+      action_list[ i ]->apl_profile.merge( other.action_list[ i ]->apl_profile );
     }
     else
     {
@@ -6108,6 +6111,72 @@ void player_t::merge( player_t& other )
 /**
  * Reset player. Called after each iteration to reset the player to its initial state.
  */
+/// Reset buffs, walking only the buffs changed since the last reset when dirty tracking is enabled
+void player_t::reset_buffs()
+{
+  if ( !sim->reset_dirty_tracking )
+  {
+    for ( auto& buff : buff_list )
+      buff->reset();
+    return;
+  }
+
+  // Resetting a buff may trigger others, which are appended to the list
+  for ( size_t i = 0; i < dirty_buff_list.size(); i++ )
+    dirty_buff_list[ i ]->reset();
+
+  // Buffs that cannot be tracked stay dirty, and are reset every iteration
+  size_t n_untracked = 0;
+  for ( auto buff : dirty_buff_list )
+  {
+    if ( buff->is_reset_tracked() )
+      buff->reset_dirty = false;
+    else
+      dirty_buff_list[ n_untracked++ ] = buff;
+  }
+  dirty_buff_list.resize( n_untracked );
+
+  if ( sim->reset_dirty_tracking > 1 )
+  {
+    for ( auto buff : buff_list )
+    {
+      if ( buff->reset_dirty || buff->is_reset_clean() )
+        continue;
+
+      sim->error( "{} buff {} changed without being marked for reset.", *this, *buff );
+      buff->reset();
+    }
+  }
+}
+
+/// Reset dots, walking only the dots changed since the last reset when dirty tracking is enabled
+void player_t::reset_dots()
+{
+  if ( !sim->reset_dirty_tracking )
+  {
+    range::for_each( dot_list, []( dot_t* dot ) { dot->reset(); } );
+    return;
+  }
+
+  range::for_each( dirty_dot_list, []( dot_t* dot ) {
+    dot->reset();
+    dot->reset_dirty = false;
+  } );
+  dirty_dot_list.clear();
+
+  if ( sim->reset_dirty_tracking > 1 )
+  {
+    for ( auto dot : dot_list )
+    {
+      if ( dot->is_reset_clean() )
+        continue;
+
+      sim->error( "{} dot {} changed without being marked for reset.", *this, dot->name_str );
+      dot->reset();
+    }
+  }
+}
+
 void player_t::reset()
 {
   sim->print_debug( "Resetting {}.", *this );
@@ -6131,8 +6200,7 @@ void player_t::reset()
 
   sim->print_debug( "{} resets current stats ( reset to initial ): {}", *this, current );
 
-  for ( auto& buff : buff_list )
-    buff->reset();
+  reset_buffs();
 
   last_foreground_action = nullptr;
   prev_gcd_actions.clear();
@@ -6194,7 +6262,7 @@ void player_t::reset()
 
   range::for_each( target_specific_cooldown_list, []( target_specific_cooldown_t* tcd ) { tcd->reset(); } );
 
-  range::for_each( dot_list, []( dot_t* dot ) { dot->reset(); } );
+  reset_dots();
 
   range::for_each( stats_list, []( stats_t* stat ) { stat->reset(); } );
 
@@ -6518,6 +6586,9 @@ void player_t::schedule_ready( timespan_t delta_time, bool waiting )
  */
 void player_t::arise()
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.target++;
+
   sim->print_log( "{} tries to arise.", *this );
 
   if ( !initial.sleeping )
@@ -6635,6 +6706,9 @@ timespan_t player_t::available() const
  */
 void player_t::demise()
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.target++;
+
   // No point in demising anything if we're not even active
   if ( current.sleeping )
     return;
@@ -6968,6 +7042,9 @@ void player_t::collect_resource_timeline_information()
 
 double player_t::resource_loss( resource_e resource_type, double amount, gain_t* source, action_t* )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.resource++;
+
   if ( amount == 0 )
     return 0.0;
 
@@ -7027,6 +7104,9 @@ double player_t::resource_loss( resource_e resource_type, double amount, gain_t*
 
 double player_t::resource_gain( resource_e resource_type, double amount, gain_t* source, action_t* action )
 {
+  if ( sim->apl_ready_cache )
+    sim->apl_versions.resource++;
+
   if ( current.sleeping || amount == 0.0 )
     return 0.0;
 
@@ -13425,6 +13505,20 @@ player_collected_data_t::action_sequence_data_t::action_sequence_data_t( const a
   }
 }
 
+namespace
+{
+// Per-iteration collectors that are only analyzed for the report. Fight length samples are needed
+// as-is to build the divisor timelines.
+template <typename Data>
+std::vector<decltype( &std::declval<Data&>().dmg )> report_sample_data( Data& cd )
+{
+  return { &cd.waiting_time, &cd.pooling_time, &cd.executed_foreground_actions, &cd.dmg, &cd.compound_dmg,
+           &cd.prioritydps, &cd.dps, &cd.dpse, &cd.dtps, &cd.dmg_taken, &cd.heal, &cd.compound_heal, &cd.hps,
+           &cd.hpse, &cd.htps, &cd.heal_taken, &cd.absorb, &cd.compound_absorb, &cd.aps, &cd.atps,
+           &cd.absorb_taken, &cd.deaths, &cd.target_metric };
+}
+}  // namespace
+
 player_collected_data_t::player_collected_data_t( const player_t* player ) :
   fight_length( player->name_str + " Fight Length", generic_container_type( player, 2 ) ),
   waiting_time( player->name_str + " Waiting Time", generic_container_type( player, 2 ) ),
@@ -13476,6 +13570,32 @@ player_collected_data_t::player_collected_data_t( const player_t* player ) :
     resource_gained.resize( RESOURCE_HEALTH + 1 );
     resource_overflowed.resize( RESOURCE_HEALTH + 1 );
   }
+
+  if ( player->sim->streaming_statistics )
+  {
+    for ( auto sd : report_sample_data( *this ) )
+      sd->change_streaming( true );
+  }
+  else if ( player->sim->compact_statistics )
+  {
+    for ( auto sd : report_sample_data( *this ) )
+      sd->change_compact( true );
+  }
+}
+
+// Heap memory held by the per-iteration samples of the actor, and the number of collectors
+size_t player_collected_data_t::sample_data_memory( size_t& collectors ) const
+{
+  size_t bytes = fight_length.memory_usage();
+  collectors++;
+
+  for ( auto sd : report_sample_data( *this ) )
+  {
+    bytes += sd->memory_usage();
+    collectors++;
+  }
+
+  return bytes;
 }
 
 void player_collected_data_t::reserve_memory( const player_t& p )
@@ -13831,12 +13951,24 @@ action_t* player_t::select_action( const action_priority_list_t& list,
     if ( a->option.wait_on_ready == 1 )
       break;
 
-    if ( a->action_ready() )
+    bool ready;
+    if ( sim->apl_ready_cache )
+      ready = a->memoized_action_ready();
+    else if ( sim->apl_profile )
+      ready = a->profiled_action_ready();
+    else
+      ready = a->action_ready();
+
+    if ( ready )
     {
       // Execute variable operation, and continue processing
       if ( a->type == ACTION_VARIABLE )
       {
+        auto var = static_cast<variable_t*>( a )->var;
+        double value = var->current_value_;
         a->execute();
+        if ( sim->apl_ready_cache && var->current_value_ != value )
+          sim->apl_versions.variable++;
         continue;
       }
       // Call_action_list action, don't execute anything, but rather recurse
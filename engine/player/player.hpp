@@ -21,6 +21,7 @@
 #include "talent.hpp"
 #include "util/cache.hpp"
 #include "util/rng.hpp"
+#include "sim/option.hpp"
 #include "sim/proc_rng.hpp"
 #include "util/util.hpp"
 #include "weapon.hpp"
@@ -183,6 +184,7 @@ struct player_t : public actor_t
 
   // Option Parsing
   std::vector<std::unique_ptr<option_t>> options;
+  opts::index_t option_index;
 
   // Stat Timelines to Display
   std::vector<stat_e> stat_timelines;
@@ -324,6 +326,8 @@ struct player_t : public actor_t
   std::string use_apl;
   bool use_default_action_list;
   auto_dispose< std::vector<dot_t*> > dot_list;
+  // Dots changed since the last reset, see sim_t::reset_dirty_tracking
+  std::vector<dot_t*> dirty_dot_list;
   auto_dispose< std::vector<action_priority_list_t*> > action_priority_list;
   std::vector<action_t*> precombat_action_list;
   action_priority_list_t* active_action_list;
@@ -361,6 +365,8 @@ struct player_t : public actor_t
   double rps_gain, rps_loss;
 
   auto_dispose<std::vector<buff_t*>> buff_list;
+  // Buffs changed since the last reset, see sim_t::reset_dirty_tracking
+  std::vector<buff_t*> dirty_buff_list;
   // buff_t::find( player, name, source ) will return pointer to sim.auras.fallback
   std::vector<std::pair<std::string, player_t*>> fallback_buff_names;
   auto_dispose<std::vector<proc_t*>> proc_list;
@@ -374,6 +380,7 @@ struct player_t : public actor_t
   std::vector<cooldown_t*> dynamic_cooldown_list;
   std::array<std::vector<plot_data_t>, STAT_MAX> dps_plot_data;
   std::vector<std::vector<plot_data_t>> reforge_plot_data;
+  std::vector<std::vector<plot_data_t>> reforge_plot_surrogate;
   auto_dispose<std::vector<sample_data_helper_t*>> sample_data_list;
   std::vector<std::unique_ptr<cooldown_waste_data_t>> cooldown_waste_data_list;
 
@@ -1132,6 +1139,8 @@ public:
   virtual void action_init_finished(action_t&);
   virtual bool verify_use_items() const;
   virtual void reset();
+  void reset_buffs();
+  void reset_dots();
   virtual void combat_begin();
   virtual void combat_end();
   virtual void precombat_init();
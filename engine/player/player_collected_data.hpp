@@ -173,5 +173,6 @@ struct player_collected_data_t
   void merge( const player_t& );
   void analyze( const player_t& );
   void collect_data( const player_t& );
+  size_t sample_data_memory( size_t& collectors ) const;
   double calculate_max_spike_damage( const health_changes_timeline_t& tl, int window );
 };
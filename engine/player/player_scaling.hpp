@@ -18,6 +18,8 @@ struct player_scaling_t
   std::array<gear_stats_t, SCALE_METRIC_MAX> scaling_normalized;
   std::array<gear_stats_t, SCALE_METRIC_MAX> scaling_error;
   std::array<gear_stats_t, SCALE_METRIC_MAX> scaling_compare_error;
+  // Variance of unpaired over paired scale factor differences, with common random numbers
+  std::array<gear_stats_t, SCALE_METRIC_MAX> scaling_variance_reduction;
   std::array<double, SCALE_METRIC_MAX> scaling_lag, scaling_lag_error;
   std::array<bool, STAT_MAX> scales_with;
   std::array<double, STAT_MAX> over_cap;
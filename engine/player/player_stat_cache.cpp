@@ -14,11 +14,11 @@
  */
 void player_stat_cache_t::invalidate_all()
 {
-  range::fill( valid, false );
-  range::fill( spell_power_valid, false );
-  range::fill( player_mult_valid, false );
-  range::fill( player_heal_mult_valid, false );
-  range::fill( weapon_attack_power_valid, false );
+  valid = 0;
+  spell_power_valid = 0;
+  player_mult_valid = 0;
+  player_heal_mult_valid = 0;
+  weapon_attack_power_valid = 0;
 }
 
 /**
@@ -29,23 +29,23 @@ void player_stat_cache_t::invalidate( cache_e c )
   switch ( c )
   {
     case CACHE_SPELL_POWER:
-      range::fill( spell_power_valid, false );
+      spell_power_valid = 0;
       break;
 
     case CACHE_WEAPON_DPS:
-      range::fill( weapon_attack_power_valid, false );
+      weapon_attack_power_valid = 0;
       break;
 
     case CACHE_PLAYER_DAMAGE_MULTIPLIER:
-      range::fill( player_mult_valid, false );
+      player_mult_valid = 0;
       break;
 
     case CACHE_PLAYER_HEAL_MULTIPLIER:
-      range::fill( player_heal_mult_valid, false );
+      player_heal_mult_valid = 0;
       break;
 
     default:
-      valid[ c ] = false;
+      valid &= ~bit( c );
       break;
   }
 }
@@ -78,9 +78,9 @@ double player_stat_cache_t::get_attribute( attribute_e a ) const
 
 double player_stat_cache_t::strength() const
 {
-  if ( !active || !valid[ CACHE_STRENGTH ] )
+  if ( !active || !is_valid( CACHE_STRENGTH ) )
   {
-    valid[ CACHE_STRENGTH ] = true;
+    valid |= bit( CACHE_STRENGTH );
     _strength               = player->strength();
   }
   else
@@ -90,9 +90,9 @@ double player_stat_cache_t::strength() const
 
 double player_stat_cache_t::agility() const
 {
-  if ( !active || !valid[ CACHE_AGILITY ] )
+  if ( !active || !is_valid( CACHE_AGILITY ) )
   {
-    valid[ CACHE_AGILITY ] = true;
+    valid |= bit( CACHE_AGILITY );
     _agility               = player->agility();
   }
   else
@@ -102,9 +102,9 @@ double player_stat_cache_t::agility() const
 
 double player_stat_cache_t::stamina() const
 {
-  if ( !active || !valid[ CACHE_STAMINA ] )
+  if ( !active || !is_valid( CACHE_STAMINA ) )
   {
-    valid[ CACHE_STAMINA ] = true;
+    valid |= bit( CACHE_STAMINA );
     _stamina               = player->stamina();
   }
   else
@@ -114,9 +114,9 @@ double player_stat_cache_t::stamina() const
 
 double player_stat_cache_t::intellect() const
 {
-  if ( !active || !valid[ CACHE_INTELLECT ] )
+  if ( !active || !is_valid( CACHE_INTELLECT ) )
   {
-    valid[ CACHE_INTELLECT ] = true;
+    valid |= bit( CACHE_INTELLECT );
     _intellect               = player->intellect();
   }
   else
@@ -126,9 +126,9 @@ double player_stat_cache_t::intellect() const
 
 double player_stat_cache_t::spirit() const
 {
-  if ( !active || !valid[ CACHE_SPIRIT ] )
+  if ( !active || !is_valid( CACHE_SPIRIT ) )
   {
-    valid[ CACHE_SPIRIT ] = true;
+    valid |= bit( CACHE_SPIRIT );
     _spirit               = player->spirit();
   }
   else
@@ -138,9 +138,9 @@ double player_stat_cache_t::spirit() const
 
 double player_stat_cache_t::spell_power( school_e s ) const
 {
-  if ( !active || !spell_power_valid[ s ] )
+  if ( !active || !( spell_power_valid & bit( s ) ) )
   {
-    spell_power_valid[ s ] = true;
+    spell_power_valid |= bit( s );
     _spell_power[ s ]      = player->composite_spell_power( s );
   }
   else
@@ -150,9 +150,9 @@ double player_stat_cache_t::spell_power( school_e s ) const
 
 double player_stat_cache_t::attack_power() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_POWER ] )
+  if ( !active || !is_valid( CACHE_ATTACK_POWER ) )
   {
-    valid[ CACHE_ATTACK_POWER ] = true;
+    valid |= bit( CACHE_ATTACK_POWER );
     _attack_power               = player->composite_melee_attack_power();
   }
   else
@@ -164,9 +164,9 @@ double player_stat_cache_t::weapon_attack_power( attack_power_type t ) const
 {
   auto type = static_cast<unsigned>( t );
 
-  if ( !active || !weapon_attack_power_valid[ type ] )
+  if ( !active || !( weapon_attack_power_valid & bit( type ) ) )
   {
-    weapon_attack_power_valid[ type ] = true;
+    weapon_attack_power_valid |= bit( type );
     _weapon_attack_power[ type ] = player->composite_weapon_attack_power_by_type( t );
   }
   else
@@ -176,9 +176,9 @@ double player_stat_cache_t::weapon_attack_power( attack_power_type t ) const
 
 double player_stat_cache_t::attack_expertise() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_EXP ] )
+  if ( !active || !is_valid( CACHE_ATTACK_EXP ) )
   {
-    valid[ CACHE_ATTACK_EXP ] = true;
+    valid |= bit( CACHE_ATTACK_EXP );
     _attack_expertise         = player->composite_melee_expertise();
   }
   else
@@ -188,9 +188,9 @@ double player_stat_cache_t::attack_expertise() const
 
 double player_stat_cache_t::attack_hit() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_HIT ] )
+  if ( !active || !is_valid( CACHE_ATTACK_HIT ) )
   {
-    valid[ CACHE_ATTACK_HIT ] = true;
+    valid |= bit( CACHE_ATTACK_HIT );
     _attack_hit               = player->composite_melee_hit();
   }
   else
@@ -206,9 +206,9 @@ double player_stat_cache_t::attack_hit() const
 
 double player_stat_cache_t::attack_crit_chance() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_CRIT_CHANCE ] )
+  if ( !active || !is_valid( CACHE_ATTACK_CRIT_CHANCE ) )
   {
-    valid[ CACHE_ATTACK_CRIT_CHANCE ] = true;
+    valid |= bit( CACHE_ATTACK_CRIT_CHANCE );
     _attack_crit_chance               = player->composite_melee_crit_chance();
   }
   else
@@ -218,9 +218,9 @@ double player_stat_cache_t::attack_crit_chance() const
 
 double player_stat_cache_t::attack_haste() const
 {
-  if ( !active || !valid[ CACHE_ATTACK_HASTE ] )
+  if ( !active || !is_valid( CACHE_ATTACK_HASTE ) )
   {
-    valid[ CACHE_ATTACK_HASTE ] = true;
+    valid |= bit( CACHE_ATTACK_HASTE );
     _attack_haste               = player->composite_melee_haste();
   }
   else
@@ -230,9 +230,9 @@ double player_stat_cache_t::attack_haste() const
 
 double player_stat_cache_t::auto_attack_speed() const
 {
-  if ( !active || !valid[ CACHE_AUTO_ATTACK_SPEED ] )
+  if ( !active || !is_valid( CACHE_AUTO_ATTACK_SPEED ) )
   {
-    valid[ CACHE_AUTO_ATTACK_SPEED ] = true;
+    valid |= bit( CACHE_AUTO_ATTACK_SPEED );
     _auto_attack_speed               = player->composite_melee_auto_attack_speed();
   }
   else
@@ -242,9 +242,9 @@ double player_stat_cache_t::auto_attack_speed() const
 
 double player_stat_cache_t::spell_hit() const
 {
-  if ( !active || !valid[ CACHE_SPELL_HIT ] )
+  if ( !active || !is_valid( CACHE_SPELL_HIT ) )
   {
-    valid[ CACHE_SPELL_HIT ] = true;
+    valid |= bit( CACHE_SPELL_HIT );
     _spell_hit               = player->composite_spell_hit();
   }
   else
@@ -254,9 +254,9 @@ double player_stat_cache_t::spell_hit() const
 
 double player_stat_cache_t::spell_crit_chance() const
 {
-  if ( !active || !valid[ CACHE_SPELL_CRIT_CHANCE ] )
+  if ( !active || !is_valid( CACHE_SPELL_CRIT_CHANCE ) )
   {
-    valid[ CACHE_SPELL_CRIT_CHANCE ] = true;
+    valid |= bit( CACHE_SPELL_CRIT_CHANCE );
     _spell_crit_chance               = player->composite_spell_crit_chance();
   }
   else
@@ -266,9 +266,9 @@ double player_stat_cache_t::spell_crit_chance() const
 
 double player_stat_cache_t::rppm_haste_coeff() const
 {
-  if ( !active || !valid[ CACHE_RPPM_HASTE ] )
+  if ( !active || !is_valid( CACHE_RPPM_HASTE ) )
   {
-    valid[ CACHE_RPPM_HASTE ] = true;
+    valid |= bit( CACHE_RPPM_HASTE );
     _rppm_haste_coeff          = 1.0 / std::min( player->cache.spell_haste(), player->cache.attack_haste() );
   }
   else
@@ -280,9 +280,9 @@ double player_stat_cache_t::rppm_haste_coeff() const
 
 double player_stat_cache_t::rppm_crit_coeff() const
 {
-  if ( !active || !valid[ CACHE_RPPM_CRIT ] )
+  if ( !active || !is_valid( CACHE_RPPM_CRIT ) )
   {
-    valid[ CACHE_RPPM_CRIT ] = true;
+    valid |= bit( CACHE_RPPM_CRIT );
     _rppm_crit_coeff          = 1.0 + std::max( player->cache.attack_crit_chance(), player->cache.spell_crit_chance() );
   }
   else
@@ -294,9 +294,9 @@ double player_stat_cache_t::rppm_crit_coeff() const
 
 double player_stat_cache_t::spell_haste() const
 {
-  if ( !active || !valid[ CACHE_SPELL_HASTE ] )
+  if ( !active || !is_valid( CACHE_SPELL_HASTE ) )
   {
-    valid[ CACHE_SPELL_HASTE ] = true;
+    valid |= bit( CACHE_SPELL_HASTE );
     _spell_haste               = player->composite_spell_haste();
   }
   else
@@ -306,9 +306,9 @@ double player_stat_cache_t::spell_haste() const
 
 double player_stat_cache_t::spell_cast_speed() const
 {
-  if ( !active || !valid[ CACHE_SPELL_CAST_SPEED ] )
+  if ( !active || !is_valid( CACHE_SPELL_CAST_SPEED ) )
   {
-    valid[ CACHE_SPELL_CAST_SPEED ] = true;
+    valid |= bit( CACHE_SPELL_CAST_SPEED );
     _spell_cast_speed               = player->composite_spell_cast_speed();
   }
   else
@@ -318,9 +318,9 @@ double player_stat_cache_t::spell_cast_speed() const
 
 double player_stat_cache_t::dodge() const
 {
-  if ( !active || !valid[ CACHE_DODGE ] )
+  if ( !active || !is_valid( CACHE_DODGE ) )
   {
-    valid[ CACHE_DODGE ] = true;
+    valid |= bit( CACHE_DODGE );
     _dodge               = player->composite_dodge();
   }
   else
@@ -330,9 +330,9 @@ double player_stat_cache_t::dodge() const
 
 double player_stat_cache_t::parry() const
 {
-  if ( !active || !valid[ CACHE_PARRY ] )
+  if ( !active || !is_valid( CACHE_PARRY ) )
   {
-    valid[ CACHE_PARRY ] = true;
+    valid |= bit( CACHE_PARRY );
     _parry               = player->composite_parry();
   }
   else
@@ -342,9 +342,9 @@ double player_stat_cache_t::parry() const
 
 double player_stat_cache_t::block() const
 {
-  if ( !active || !valid[ CACHE_BLOCK ] )
+  if ( !active || !is_valid( CACHE_BLOCK ) )
   {
-    valid[ CACHE_BLOCK ] = true;
+    valid |= bit( CACHE_BLOCK );
     _block               = player->composite_block();
   }
   else
@@ -354,9 +354,9 @@ double player_stat_cache_t::block() const
 
 double player_stat_cache_t::crit_block() const
 {
-  if ( !active || !valid[ CACHE_CRIT_BLOCK ] )
+  if ( !active || !is_valid( CACHE_CRIT_BLOCK ) )
   {
-    valid[ CACHE_CRIT_BLOCK ] = true;
+    valid |= bit( CACHE_CRIT_BLOCK );
     _crit_block               = player->composite_crit_block();
   }
   else
@@ -366,9 +366,9 @@ double player_stat_cache_t::crit_block() const
 
 double player_stat_cache_t::crit_avoidance() const
 {
-  if ( !active || !valid[ CACHE_CRIT_AVOIDANCE ] )
+  if ( !active || !is_valid( CACHE_CRIT_AVOIDANCE ) )
   {
-    valid[ CACHE_CRIT_AVOIDANCE ] = true;
+    valid |= bit( CACHE_CRIT_AVOIDANCE );
     _crit_avoidance               = player->composite_crit_avoidance();
   }
   else
@@ -378,9 +378,9 @@ double player_stat_cache_t::crit_avoidance() const
 
 double player_stat_cache_t::miss() const
 {
-  if ( !active || !valid[ CACHE_MISS ] )
+  if ( !active || !is_valid( CACHE_MISS ) )
   {
-    valid[ CACHE_MISS ] = true;
+    valid |= bit( CACHE_MISS );
     _miss               = player->composite_miss();
   }
   else
@@ -390,9 +390,9 @@ double player_stat_cache_t::miss() const
 
 double player_stat_cache_t::armor() const
 {
-  if ( !active || !valid[ CACHE_ARMOR ] || !valid[ CACHE_BONUS_ARMOR ] )
+  if ( !active || !is_valid( CACHE_ARMOR ) || !is_valid( CACHE_BONUS_ARMOR ) )
   {
-    valid[ CACHE_ARMOR ] = true;
+    valid |= bit( CACHE_ARMOR );
     _armor               = player->composite_armor();
   }
   else
@@ -402,9 +402,9 @@ double player_stat_cache_t::armor() const
 
 double player_stat_cache_t::mastery() const
 {
-  if ( !active || !valid[ CACHE_MASTERY ] )
+  if ( !active || !is_valid( CACHE_MASTERY ) )
   {
-    valid[ CACHE_MASTERY ] = true;
+    valid |= bit( CACHE_MASTERY );
     _mastery               = player->composite_mastery();
     _mastery_value         = player->composite_mastery_value();
   }
@@ -420,9 +420,9 @@ double player_stat_cache_t::mastery() const
  */
 double player_stat_cache_t::mastery_value() const
 {
-  if ( !active || !valid[ CACHE_MASTERY ] )
+  if ( !active || !is_valid( CACHE_MASTERY ) )
   {
-    valid[ CACHE_MASTERY ] = true;
+    valid |= bit( CACHE_MASTERY );
     _mastery               = player->composite_mastery();
     _mastery_value         = player->composite_mastery_value();
   }
@@ -433,9 +433,9 @@ double player_stat_cache_t::mastery_value() const
 
 double player_stat_cache_t::bonus_armor() const
 {
-  if ( !active || !valid[ CACHE_BONUS_ARMOR ] )
+  if ( !active || !is_valid( CACHE_BONUS_ARMOR ) )
   {
-    valid[ CACHE_BONUS_ARMOR ] = true;
+    valid |= bit( CACHE_BONUS_ARMOR );
     _bonus_armor               = player->composite_bonus_armor();
   }
   else
@@ -445,9 +445,9 @@ double player_stat_cache_t::bonus_armor() const
 
 double player_stat_cache_t::damage_versatility() const
 {
-  if ( !active || !valid[ CACHE_DAMAGE_VERSATILITY ] )
+  if ( !active || !is_valid( CACHE_DAMAGE_VERSATILITY ) )
   {
-    valid[ CACHE_DAMAGE_VERSATILITY ] = true;
+    valid |= bit( CACHE_DAMAGE_VERSATILITY );
     _damage_versatility               = player->composite_damage_versatility();
   }
   else
@@ -457,9 +457,9 @@ double player_stat_cache_t::damage_versatility() const
 
 double player_stat_cache_t::heal_versatility() const
 {
-  if ( !active || !valid[ CACHE_HEAL_VERSATILITY ] )
+  if ( !active || !is_valid( CACHE_HEAL_VERSATILITY ) )
   {
-    valid[ CACHE_HEAL_VERSATILITY ] = true;
+    valid |= bit( CACHE_HEAL_VERSATILITY );
     _heal_versatility               = player->composite_heal_versatility();
   }
   else
@@ -469,9 +469,9 @@ double player_stat_cache_t::heal_versatility() const
 
 double player_stat_cache_t::mitigation_versatility() const
 {
-  if ( !active || !valid[ CACHE_MITIGATION_VERSATILITY ] )
+  if ( !active || !is_valid( CACHE_MITIGATION_VERSATILITY ) )
   {
-    valid[ CACHE_MITIGATION_VERSATILITY ] = true;
+    valid |= bit( CACHE_MITIGATION_VERSATILITY );
     _mitigation_versatility               = player->composite_mitigation_versatility();
   }
   else
@@ -481,9 +481,9 @@ double player_stat_cache_t::mitigation_versatility() const
 
 double player_stat_cache_t::leech() const
 {
-  if ( !active || !valid[ CACHE_LEECH ] )
+  if ( !active || !is_valid( CACHE_LEECH ) )
   {
-    valid[ CACHE_LEECH ] = true;
+    valid |= bit( CACHE_LEECH );
     _leech               = player->composite_leech();
   }
   else
@@ -493,9 +493,9 @@ double player_stat_cache_t::leech() const
 
 double player_stat_cache_t::run_speed() const
 {
-  if ( !active || !valid[ CACHE_RUN_SPEED ] )
+  if ( !active || !is_valid( CACHE_RUN_SPEED ) )
   {
-    valid[ CACHE_RUN_SPEED ] = true;
+    valid |= bit( CACHE_RUN_SPEED );
     _run_speed               = player->composite_movement_speed();
   }
   else
@@ -505,9 +505,9 @@ double player_stat_cache_t::run_speed() const
 
 double player_stat_cache_t::avoidance() const
 {
-  if ( !active || !valid[ CACHE_AVOIDANCE ] )
+  if ( !active || !is_valid( CACHE_AVOIDANCE ) )
   {
-    valid[ CACHE_AVOIDANCE ] = true;
+    valid |= bit( CACHE_AVOIDANCE );
     _avoidance               = player->composite_avoidance();
   }
   else
@@ -517,9 +517,9 @@ double player_stat_cache_t::avoidance() const
 
 double player_stat_cache_t::corruption() const
 {
-  if ( !active || !valid[ CACHE_CORRUPTION ] )
+  if ( !active || !is_valid( CACHE_CORRUPTION ) )
   {
-    valid[ CACHE_CORRUPTION ] = true;
+    valid |= bit( CACHE_CORRUPTION );
     _corruption               = player->composite_corruption();
   }
   else
@@ -529,9 +529,9 @@ double player_stat_cache_t::corruption() const
 
 double player_stat_cache_t::corruption_resistance() const
 {
-  if ( !active || !valid[ CACHE_CORRUPTION_RESISTANCE ] )
+  if ( !active || !is_valid( CACHE_CORRUPTION_RESISTANCE ) )
   {
-    valid[ CACHE_CORRUPTION_RESISTANCE ] = true;
+    valid |= bit( CACHE_CORRUPTION_RESISTANCE );
     _corruption_resistance               = player->composite_corruption_resistance();
   }
   else
@@ -541,9 +541,9 @@ double player_stat_cache_t::corruption_resistance() const
 
 double player_stat_cache_t::player_multiplier( school_e s ) const
 {
-  if ( !active || !player_mult_valid[ s ] )
+  if ( !active || !( player_mult_valid & bit( s ) ) )
   {
-    player_mult_valid[ s ] = true;
+    player_mult_valid |= bit( s );
     _player_mult[ s ]      = player->composite_player_multiplier( s );
   }
   else
@@ -555,9 +555,9 @@ double player_stat_cache_t::player_heal_multiplier( const action_state_t* s ) co
 {
   school_e sch = s->action->get_school();
 
-  if ( !active || !player_heal_mult_valid[ sch ] )
+  if ( !active || !( player_heal_mult_valid & bit( sch ) ) )
   {
-    player_heal_mult_valid[ sch ] = true;
+    player_heal_mult_valid |= bit( sch );
     _player_heal_mult[ sch ]      = player->composite_player_heal_multiplier( s );
   }
   else
@@ -8,6 +8,7 @@
 #include "config.hpp"
 #include "sc_enums.hpp"
 #include <array>
+#include <cstdint>
 
 
 struct action_state_t;
@@ -35,39 +36,52 @@ struct player_t;
  * virtual player_t::invalidate_cache( cache_e ) function.
  *
  * Attention: player_t::invalidate_cache( cache_e ) is recursive and may call itself again.
+ *
+ * The 'valid'-states are bitmasks, one bit per cache_e (or school / attack power type).
  */
 struct player_stat_cache_t
 {
+  using mask_t = uint64_t;
+  static_assert( CACHE_MAX <= 64, "cache_e does not fit the valid mask" );
+  static_assert( SCHOOL_MAX + 1 <= 64, "school_e does not fit the valid mask" );
+
   const player_t* player;
-  mutable std::array<bool, CACHE_MAX> valid;
-  mutable std::array<bool, SCHOOL_MAX + 1> spell_power_valid, player_mult_valid, player_heal_mult_valid;
-  mutable std::array<bool, static_cast<unsigned>( attack_power_type::NONE )> weapon_attack_power_valid;
   // 'valid'-states
+  mutable mask_t valid;
+  mutable mask_t spell_power_valid, player_mult_valid, player_heal_mult_valid;
+  mutable mask_t weapon_attack_power_valid;
 private:
-  // cached values
+  // cached values, ordered so the ones read by most action executes share cache lines
+  mutable std::array<double, SCHOOL_MAX + 1> _player_mult;
+  mutable double _attack_haste, _spell_haste;
+  mutable double _attack_crit_chance, _spell_crit_chance;
+  mutable double _mastery, _mastery_value;
+  mutable double _damage_versatility, _heal_versatility, _mitigation_versatility;
+  mutable double _attack_power;
+  mutable double _rppm_haste_coeff, _rppm_crit_coeff;
+  mutable double _auto_attack_speed, _spell_cast_speed;
   mutable double _strength, _agility, _stamina, _intellect, _spirit;
   mutable std::array<double, SCHOOL_MAX + 1> _spell_power;
-  mutable double  _attack_power;
   mutable std::array<double, static_cast<unsigned>( attack_power_type::NONE )> _weapon_attack_power;
   mutable double _attack_expertise;
   mutable double _attack_hit, _spell_hit;
-  mutable double _attack_crit_chance, _spell_crit_chance;
-  mutable double _attack_haste, _spell_haste;
-  mutable double _auto_attack_speed, _spell_cast_speed;
   mutable double _dodge, _parry, _block, _crit_block, _armor, _bonus_armor;
-  mutable double _mastery, _mastery_value, _crit_avoidance, _miss;
-  mutable std::array<double, SCHOOL_MAX + 1> _player_mult;
+  mutable double _crit_avoidance, _miss;
   mutable std::array<double, SCHOOL_MAX + 1> _player_heal_mult;
-  mutable double _damage_versatility, _heal_versatility, _mitigation_versatility;
   mutable double _leech, _run_speed, _avoidance;
-  mutable double _rppm_haste_coeff, _rppm_crit_coeff;
   mutable double _corruption, _corruption_resistance;
+
+  static constexpr mask_t bit( unsigned i )
+  { return mask_t( 1 ) << i; }
 public:
   bool active; // runtime active-flag
   void invalidate_all();
   void invalidate( cache_e );
+  bool is_valid( cache_e c ) const
+  { return ( valid & bit( c ) ) != 0; }
   double get_attribute( attribute_e ) const;
   player_stat_cache_t( const player_t* p ) : player( p ), active( false ) { invalidate_all(); }
+
 #if defined(SC_USE_STAT_CACHE)
   // Cache stat functions
   double strength() const;
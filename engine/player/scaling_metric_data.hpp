@@ -19,16 +19,18 @@ struct scaling_metric_data_t
   std::string name;
   double value, stddev;
   scale_metric_e metric;
+  // Per-iteration samples of the metric, if it is backed by sample data
+  const extended_sample_data_t* samples;
   scaling_metric_data_t( scale_metric_e m, util::string_view n, double v, double dev )
-    : name( n ), value( v ), stddev( dev ), metric( m )
+    : name( n ), value( v ), stddev( dev ), metric( m ), samples( nullptr )
   {
   }
   scaling_metric_data_t( scale_metric_e m, const extended_sample_data_t& sd )
-    : name( sd.name_str ), value( sd.mean() ), stddev( sd.mean_std_dev ), metric( m )
+    : name( sd.name_str ), value( sd.mean() ), stddev( sd.mean_std_dev ), metric( m ), samples( &sd )
   {
   }
   scaling_metric_data_t( scale_metric_e m, const sc_timeline_t& tl, util::string_view name )
-    : name( name ), value( tl.mean() ), stddev( tl.mean_stddev() ), metric( m )
+    : name( name ), value( tl.mean() ), stddev( tl.mean_stddev() ), metric( m ), samples( nullptr )
   {
   }
 };
\ No newline at end of file
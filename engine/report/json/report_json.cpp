@@ -237,6 +237,35 @@ void procs_to_json( JsonOutput root, const player_t& p )
   } );
 }
 
+void apl_profile_to_json( JsonOutput root, const player_t& p )
+{
+  root.make_array();
+  range::for_each( p.action_list, [ & ]( const action_t* a ) {
+    const auto& prof = a->apl_profile;
+    if ( prof.evaluations == 0 || !a->action_list )
+    {
+      return;
+    }
+
+    auto node = root.add();
+    node[ "list" ] = a->action_list->name_str;
+    node[ "name" ] = a->name();
+    node[ "line" ] = a->signature_str;
+    node[ "evaluations" ] = prof.evaluations;
+    node[ "passes" ] = prof.passes;
+    if ( prof.if_samples )
+    {
+      node[ "if_samples" ] = prof.if_samples;
+      node[ "if_time" ] = prof.if_time / prof.if_samples;
+    }
+    if ( prof.target_if_samples )
+    {
+      node[ "target_if_samples" ] = prof.target_if_samples;
+      node[ "target_if_time" ] = prof.target_if_time / prof.target_if_samples;
+    }
+  } );
+}
+
 bool has_valid_stats( const std::vector<stats_t*>& stats_list, int level = 0 )
 {
   return range::any_of( stats_list, [ level ]( const stats_t* stats ) {
@@ -872,6 +901,11 @@ void to_json( JsonOutput& arr, const ::report::json::report_configuration_t& rep
       gains_to_json( root[ "gains" ], p );
     }
 
+    if ( p.sim->apl_profile )
+    {
+      apl_profile_to_json( root[ "apl_profile" ], p );
+    }
+
     stats_to_json( root[ "stats" ], p.stats_list );
 
     // add pet stats as a separate property
@@ -1021,6 +1055,11 @@ void profileset_json2( const profileset::profilesets_t& profileset, const sim_t&
 
                      obj[ "iterations" ] = as<uint64_t>( result.iterations() );
 
+                     if ( profileset->eliminated_round() > 0 )
+                     {
+                       obj[ "eliminated_round" ] = profileset->eliminated_round();
+                     }
+
                      if ( profileset->results() > 1 )
                      {
                        auto results2 = obj[ "additional_metrics" ].make_array();
@@ -1065,6 +1104,10 @@ void profileset_json3( const profileset::profilesets_t& profilesets, const sim_t
                    [ &results, &sim ]( const profileset::profilesets_t::profileset_entry_t& profileset ) {
                      auto&& obj = results.add();
                      obj[ "name" ] = profileset->name();
+                     if ( profileset->eliminated_round() > 0 )
+                     {
+                       obj[ "eliminated_round" ] = profileset->eliminated_round();
+                     }
                      auto results_obj = obj[ "metrics" ].make_array();
 
                      for ( size_t midx = 0; midx < sim.profileset_metric.size(); ++midx )
@@ -1115,6 +1158,18 @@ void profileset_json( const ::report::json::report_configuration_t& report_confi
   {
     profileset_json2( profileset, sim, root );
   }
+
+  if ( profileset.warm_reused() > 0 )
+  {
+    root[ "warm_sims" ][ "reused" ] = as<uint64_t>( profileset.warm_reused() );
+    root[ "warm_sims" ][ "validate_time" ] = chrono::to_fp_seconds( profileset.validate_time() );
+    root[ "warm_sims" ][ "init_time_saved" ] = chrono::to_fp_seconds( profileset.saved_init_time() );
+  }
+
+  if ( profileset.eliminated() > 0 )
+  {
+    root[ "racing" ][ "eliminated" ] = as<uint64_t>( profileset.eliminated() );
+  }
 #endif
 }
 
@@ -1177,6 +1232,23 @@ void reforge_plot_json( const ::report::json::report_configuration_t& /* report_
       dobj[ "dps" ] = player->reforge_plot_data[ i ][ j ].value;
       dobj[ "dps-error" ] = player->reforge_plot_data[ i ][ j ].error;
     }
+
+    if ( !player->reforge_plot_surrogate.empty() )
+    {
+      auto surrogate_obj = obj[ "surrogate" ].make_array();
+
+      for ( const auto& row : player->reforge_plot_surrogate )
+      {
+        auto&& dobj = surrogate_obj.add();
+        for ( size_t j = 0; j < stat_list.size(); j++ )
+        {
+          dobj[ util::stat_type_abbrev( stat_list[ j ] ) ] = row[ j ].value;
+        }
+
+        dobj[ "dps" ] = row.back().value;
+        dobj[ "dps-confidence" ] = row.back().error;
+      }
+    }
   }
 }
 
@@ -1301,6 +1373,7 @@ void to_json( const ::report::json::report_configuration_t& report_configuration
   stats_root[ "init_time_seconds" ] = chrono::to_fp_seconds( sim.init_time );
   stats_root[ "merge_time_seconds" ] = chrono::to_fp_seconds( sim.merge_time );
   stats_root[ "analyze_time_seconds" ] = chrono::to_fp_seconds( sim.analyze_time );
+  stats_root[ "analyze_threads" ] = sim.analyze_workers;
   stats_root[ "simulation_length" ] = sim.simulation_length;
   stats_root[ "total_events_processed" ] = sim.event_mgr.total_events_processed;
   add_non_zero( stats_root, "raid_dps", sim.raid_dps );
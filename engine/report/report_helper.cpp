@@ -670,6 +670,13 @@ void report_helper::print_html_sample_data( report::sc_html_stream& os, const pl
         "<tr>\n<td class=\"left\">( 95th Percentile - 5th Percentile )</td>\n"
         "<td class=\"right\">%.2f</td>\n</tr>\n",
         data.percentile( 0.95 ) - data.percentile( 0.05 ) );
+    if ( data.streaming )
+    {
+      os.printf(
+          "<tr>\n<td class=\"left\">Percentile Rank Error ( 5th / 95th, streaming )</td>\n"
+          "<td class=\"right\">%.2f%% / %.2f%%</td>\n</tr>\n",
+          data.percentile_error( 0.05 ) * 100, data.percentile_error( 0.95 ) * 100 );
+    }
 
     os << "<tr>\n"
        << "<th class=\"left\" colspan=\"2\">Mean Distribution</th>\n"
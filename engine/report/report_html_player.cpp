@@ -4772,6 +4772,73 @@ void print_html_player_cooldown_waste( report::sc_html_stream& os, const player_
         "</div>\n";
 }
 
+// print_html_player_apl_profile ============================================
+
+void print_html_player_apl_profile( report::sc_html_stream& os, const player_t& p )
+{
+  if ( !p.sim->apl_profile )
+    return;
+
+  // Estimated expression cost of a line, evaluations times the sampled mean expression time
+  auto cost = []( const action_t* a ) {
+    const auto& prof = a->apl_profile;
+    double t = 0;
+    if ( prof.if_samples )
+      t += prof.if_time / prof.if_samples;
+    if ( prof.target_if_samples )
+      t += prof.target_if_time / prof.target_if_samples;
+    return t * prof.evaluations;
+  };
+
+  std::vector<const action_t*> lines;
+  range::copy_if( p.action_list, std::back_inserter( lines ),
+                  []( const action_t* a ) { return a->apl_profile.evaluations > 0 && a->action_list; } );
+  if ( lines.empty() )
+    return;
+
+  range::sort( lines, [ &cost ]( const action_t* l, const action_t* r ) { return cost( l ) > cost( r ); } );
+
+  os << "<div class=\"player-section custom_section\">\n"
+        "<h3 class=\"toggle\">APL Profile</h3>\n"
+        "<div class=\"toggle-content hide\">\n"
+        "<table class=\"sc sort even\">\n"
+        "<thead>\n"
+        "<tr>\n"
+        "<th class=\"toggle-sort left\" data-sortdir=\"asc\" data-sorttype=\"alpha\">List</th>\n"
+        "<th class=\"toggle-sort left\" data-sortdir=\"asc\" data-sorttype=\"alpha\">Action</th>\n"
+        "<th class=\"toggle-sort\">Evaluations</th>\n"
+        "<th class=\"toggle-sort\">Passed</th>\n"
+        "<th class=\"toggle-sort\">if= (ns)</th>\n"
+        "<th class=\"toggle-sort\">target_if= (ns)</th>\n"
+        "<th class=\"toggle-sort\">Est. Time (ms)</th>\n"
+        "<th class=\"left\">Line</th>\n"
+        "</tr>\n"
+        "</thead>\n";
+
+  for ( const action_t* a : lines )
+  {
+    const auto& prof = a->apl_profile;
+    os.format( R"(<tr class="right"><td class="left">{}</td><td class="left">{}</td>)"
+               "<td>{}</td>"
+               "<td>{:.1f}%</td>"
+               "<td>{}</td>"
+               "<td>{}</td>"
+               "<td>{:.3f}</td>"
+               R"(<td class="left">{}</td></tr>)"
+               "\n",
+               util::encode_html( a->action_list->name_str ), report_decorators::decorated_action( *a ),
+               prof.evaluations, 100.0 * prof.passes / prof.evaluations,
+               prof.if_samples ? fmt::format( "{:.1f}", 1e9 * prof.if_time / prof.if_samples ) : "",
+               prof.target_if_samples ? fmt::format( "{:.1f}", 1e9 * prof.target_if_time / prof.target_if_samples )
+                                      : "",
+               1e3 * cost( a ), util::encode_html( a->signature_str ) );
+  }
+
+  os << "</table>\n"
+        "</div>\n"
+        "</div>\n";
+}
+
 // print_html_player_deaths =================================================
 
 void print_html_player_deaths( report::sc_html_stream& os, const player_t& p,
@@ -4872,6 +4939,8 @@ void print_html_player_( report::sc_html_stream& os, const player_t& p )
 
   print_html_player_action_priority_list( os, p );
 
+  print_html_player_apl_profile( os, p );
+
   print_html_stats( os, p );
 
   print_html_gear( os, p );
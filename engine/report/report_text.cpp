@@ -4,6 +4,7 @@
 // ==========================================================================
 
 #include "simulationcraft.hpp"
+#include "action/action_state.hpp"
 #include "player/covenant.hpp"
 #include "reports.hpp"
 #include "report/report_timer.hpp"
@@ -15,6 +16,7 @@
 #include "fmt/chrono.h"
 
 #include <iostream>
+#include <numeric>
 
 namespace
 {  // UNNAMED NAMESPACE ==========================================
@@ -753,14 +755,30 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
   if ( sim -> threads > 1 )
     iterations_str = fmt::format( " ({})", fmt::join( sim -> work_per_thread, ", " ) );
 
+  // Chunked work queue claims, as claimed iterations / claims per thread
+  std::string claims_str;
+  if ( sim -> work_queue -> is_chunked() )
+  {
+    std::vector<std::string> thread_claims;
+    for ( size_t i = 0; i < sim -> work_claims_per_thread.size(); ++i )
+      thread_claims.push_back( fmt::format( "{}/{}", sim -> work_claimed_per_thread[ i ], sim -> work_claims_per_thread[ i ] ) );
+
+    claims_str = fmt::format( "  WorkClaims    = {}/{} ({})\n",
+        std::accumulate( sim -> work_claimed_per_thread.begin(), sim -> work_claimed_per_thread.end(), size_t( 0 ) ),
+        std::accumulate( sim -> work_claims_per_thread.begin(), sim -> work_claims_per_thread.end(), size_t( 0 ) ),
+        fmt::join( thread_claims, ", " ) );
+  }
+
   fmt::print(
       os,
       "\n\nBaseline Performance:\n"
       "  Networking    = {}\n"
       "  RNG Engine    = {}{}\n"
       "  Iterations    = {}{}\n"
+      "{}"
       "  TotalEvents   = {}\n"
       "  MaxEventQueue = {}\n"
+      "  EventWheel    = {}\n"
 #ifdef EVENT_QUEUE_DEBUG
       "  AllocEvents   = {}\n"
       "  EndInsert     = {} ({:.3f}%)\n"
@@ -773,15 +791,17 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
       "  WallSeconds   = {}\n"
       "  InitSeconds   = {}\n"
       "  MergeSeconds  = {}\n"
-      "  AnalyzeSeconds= {}\n"
+      "  AnalyzeSeconds= {} ({} threads)\n"
       "  SpeedUp       = {:.0f}\n"
       "  EndTime       = {:%Y-%m-%d %H:%M:%S%z} ({})\n\n",
       SC_NO_NETWORKING_ON ? "disabled" : "enabled",
       sim->rng().name(), sim->deterministic ? " (deterministic)" : "",
       sim->iterations,
       sim -> threads > 1 ? iterations_str : "",
+      claims_str,
       sim->event_mgr.total_events_processed,
       sim->event_mgr.max_events_remaining,
+      sim->event_mgr.hierarchical ? "hierarchical" : "reference",
 #ifdef EVENT_QUEUE_DEBUG
       sim->event_mgr.n_allocated_events, sim->event_mgr.n_end_insert,
       100.0 * static_cast<double>( sim->event_mgr.n_end_insert ) /
@@ -795,7 +815,7 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
       chrono::to_fp_seconds(sim->elapsed_time),
       chrono::to_fp_seconds(sim->init_time),
       chrono::to_fp_seconds(sim->merge_time),
-      chrono::to_fp_seconds(sim->analyze_time),
+      chrono::to_fp_seconds(sim->analyze_time), sim->analyze_workers,
       sim->iterations * sim->simulation_length.mean() / chrono::to_fp_seconds(sim->elapsed_cpu),
       fmt::localtime(cur_time), cur_time );
 #ifdef EVENT_QUEUE_DEBUG
@@ -822,33 +842,50 @@ void sim_summary_performance( std::ostream& os, sim_t* sim )
   fmt::print( os, "Total: {:.3f}% Samples: {}\n",
       total_p,
       sim->event_mgr.events_added );
+#endif
+}
+
+void print_event_allocation( std::ostream& os, const sim_t& sim )
+{
+  const auto& mgr = sim.event_mgr;
+  if ( !mgr.collect_size_histogram || mgr.n_requested_events == 0 )
+    return;
 
   fmt::print( os, "\nEvent Queue Allocation:\n" );
   double total_a = 0;
-  for ( size_t i = 0; i < sim->event_mgr.event_requested_size_count.size();
-        ++i )
+  for ( size_t i = 0; i < mgr.event_requested_size_count.size(); ++i )
   {
-    auto& count = sim->event_mgr.event_requested_size_count[ i ];
+    auto count = mgr.event_requested_size_count[ i ];
     if ( count == 0 )
     {
       continue;
     }
 
-    double p = 100.0 * static_cast<double>( count ) / sim->event_mgr.n_requested_events;
-    fmt::print( os, "Alloc-Size: {:4} Samples: {:7} ({:6.3f}%)\n",
+    double p = 100.0 * static_cast<double>( count ) / mgr.n_requested_events;
+    fmt::print( os, "Alloc-Size: {:4} Size-Class: {:4} Samples: {:9} ({:6.3f}%)\n",
         i,
+        ( event_manager_t::size_class( i ) + 1 ) * event_manager_t::EVENT_ALIGN,
         count,
         p );
 
     total_a += p;
   }
 
-  fmt::print( os, "Total: {:.3f}% Alloc Samples: {}\n",
-      total_p,
-      sim->event_mgr.n_requested_events );
-  fmt::print( os, "Alloc size used for event_t: {}\n",
-      util::next_power_of_two( 2 * sizeof( event_t ) ) );
-#endif
+  fmt::print( os, "Total: {:.3f}% Alloc Samples: {}\n", total_a, mgr.n_requested_events );
+
+  for ( size_t i = 0; i < mgr.event_pools.size(); ++i )
+  {
+    const auto& pool = mgr.event_pools[ i ];
+    if ( pool.n_slabs == 0 )
+    {
+      continue;
+    }
+
+    fmt::print( os, "Size-Class: {:4} Slabs: {:4} Events: {}\n",
+        ( i + 1 ) * event_manager_t::EVENT_ALIGN,
+        pool.n_slabs,
+        pool.n_allocated );
+  }
 }
 
 void print_raid_scale_factors( std::ostream& os, sim_t* sim )
@@ -947,6 +984,21 @@ void print_player_scale_factors( std::ostream& os, const player_t& p,
 
   fmt::print( os, "\n" );
 
+  if ( p.sim->scaling->crn )
+  {
+    fmt::print( os, "    CRN Variance Reduction :" );
+    for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+    {
+      if ( p.scaling->scales_with[ i ] && p.scaling->scaling_variance_reduction[ sm ].get_stat( i ) > 0 )
+      {
+        fmt::print( os, "  {}={:.1f}x",
+            util::stat_type_abbrev( i ),
+            p.scaling->scaling_variance_reduction[ sm ].get_stat( i ) );
+      }
+    }
+    fmt::print( os, "\n" );
+  }
+
   std::string wowhead_std = ri.gear_weights_wowhead_std_link[ sm ];
   simplify_html( wowhead_std );
 
@@ -1107,6 +1159,150 @@ void print_event_manager_infos( std::ostream& os, const sim_t& sim )
 #endif
 }
 
+void print_expression_benchmark( std::ostream& os, const sim_t& sim )
+{
+  if ( !sim.expression_benchmark || sim.expression_benchmark_evaluations == 0 )
+    return;
+
+  auto n = static_cast<double>( sim.expression_benchmark_evaluations );
+  fmt::print( os, "\nExpression Benchmark:\n" );
+  fmt::print( os, "  Evaluations = {}\n", sim.expression_benchmark_evaluations );
+  fmt::print( os, "  Tree        = {:.2f}ns / evaluation\n", 1e9 * sim.expression_benchmark_tree_time / n );
+  fmt::print( os, "  Bytecode    = {:.2f}ns / evaluation\n", 1e9 * sim.expression_benchmark_program_time / n );
+  if ( sim.expression_benchmark_program_time > 0 )
+  {
+    fmt::print( os, "  SpeedUp     = {:.2f}\n",
+                sim.expression_benchmark_tree_time / sim.expression_benchmark_program_time );
+  }
+  fmt::print( os, "  Mismatches  = {}\n", sim.expression_benchmark_mismatches );
+}
+
+void print_name_index_benchmark( std::ostream& os, const sim_t& sim )
+{
+  if ( !sim.name_index_benchmark_data || sim.name_index_benchmark_data->lookups == 0 )
+    return;
+
+  const auto& benchmark = *sim.name_index_benchmark_data;
+
+  auto n = static_cast<double>( benchmark.lookups );
+  fmt::print( os, "\nName Index Benchmark:\n" );
+  fmt::print( os, "  Lookups    = {}\n", benchmark.lookups );
+  fmt::print( os, "  Indexed    = {:.2f}ns / lookup\n", benchmark.indexed_ns / n );
+  fmt::print( os, "  Linear     = {:.2f}ns / lookup\n", benchmark.linear_ns / n );
+  if ( benchmark.indexed_ns > 0 )
+  {
+    fmt::print( os, "  SpeedUp    = {:.2f}\n", static_cast<double>( benchmark.linear_ns ) / benchmark.indexed_ns );
+  }
+  fmt::print( os, "  TimeSaved  = {:.3f}ms\n", ( benchmark.linear_ns - benchmark.indexed_ns ) / 1e6 );
+  fmt::print( os, "  Mismatches = {}\n", benchmark.mismatches );
+}
+
+void print_apl_ready_cache( std::ostream& os, const sim_t& sim )
+{
+  if ( !sim.apl_ready_cache || sim.apl_ready_cache_lookups == 0 )
+    return;
+
+  fmt::print( os, "\nAPL Readiness Cache:\n" );
+  fmt::print( os, "  Lookups    = {}\n", sim.apl_ready_cache_lookups );
+  fmt::print( os, "  Hits       = {} ({:.1f}%)\n", sim.apl_ready_cache_hits,
+              100.0 * sim.apl_ready_cache_hits / sim.apl_ready_cache_lookups );
+  if ( sim.apl_ready_cache > 1 )
+    fmt::print( os, "  Mismatches = {}\n", sim.apl_ready_cache_mismatches );
+}
+
+void print_action_state_infos( std::ostream& os, const sim_t& sim )
+{
+  if ( !sim.action_state_arena )
+    return;
+
+  const auto& stats = sim.action_state_arena->stats();
+  fmt::print( os, "\nAction State Arena:\n" );
+  fmt::print( os, "  Allocations={} PeakLive={} SlabMemory={:.1f}KiB\n", stats.allocations, stats.peak_live,
+              stats.slab_bytes / 1024.0 );
+
+  if ( !sim.report_details )
+    return;
+
+  auto print_actor = [ &os ]( const player_t* p ) {
+    std::vector<const action_t*> actions;
+    for ( const auto& a : p->action_list )
+    {
+      if ( a->state_allocations > 0 )
+        actions.push_back( a );
+    }
+
+    if ( actions.empty() )
+      return;
+
+    range::sort( actions, []( const action_t* l, const action_t* r ) {
+      return l->state_allocations > r->state_allocations;
+    } );
+
+    fmt::print( os, "  {}:\n", p->name() );
+    for ( const auto& a : actions )
+    {
+      fmt::print( os, "    {:<32} allocations={:<6} peak={}\n", a->name(), a->state_allocations, a->state_peak );
+    }
+  };
+
+  for ( const auto& p : sim.player_no_pet_list )
+  {
+    print_actor( p );
+    for ( const auto& pet : p->pet_list )
+      print_actor( pet );
+  }
+}
+
+void print_sample_data_memory( std::ostream& os, const sim_t& sim )
+{
+  struct usage_t
+  {
+    const player_t* player;
+    size_t collectors, bytes;
+  };
+
+  std::vector<usage_t> usage;
+  size_t total_collectors = 0, total_bytes = 0;
+  for ( const auto& p : sim.player_list )
+  {
+    usage_t u{ p, 0, 0 };
+    u.bytes = p->collected_data.sample_data_memory( u.collectors );
+    for ( const auto& s : p->stats_list )
+    {
+      for ( const auto sd : { &s->actual_amount, &s->total_amount, &s->portion_aps, &s->portion_apse } )
+      {
+        u.bytes += sd->memory_usage();
+        u.collectors++;
+      }
+    }
+
+    total_collectors += u.collectors;
+    total_bytes += u.bytes;
+    usage.push_back( u );
+  }
+
+  if ( total_bytes == 0 )
+    return;
+
+  fmt::print( os, "\nSample Data Memory{}:\n",
+              sim.streaming_statistics ? " (streaming)" : sim.compact_statistics ? " (compact)" : "" );
+  fmt::print( os, "  Collectors={} Memory={:.1f}KiB PerCollector={:.0f}B\n", total_collectors, total_bytes / 1024.0,
+              static_cast<double>( total_bytes ) / total_collectors );
+
+  if ( !sim.report_details )
+    return;
+
+  range::sort( usage, []( const usage_t& l, const usage_t& r ) { return l.bytes > r.bytes; } );
+  for ( const auto& u : usage )
+  {
+    if ( u.bytes == 0 )
+      continue;
+
+    fmt::print( os, "  {:<32} collectors={:<5} memory={:.1f}KiB per_collector={:.0f}B\n", u.player->name(),
+                u.collectors, u.bytes / 1024.0, static_cast<double>( u.bytes ) / u.collectors );
+  }
+}
+
 #ifndef NDEBUG
 void print_truncated_guass_counts( std::ostream& os, const sim_t& sim )
 {
@@ -1153,6 +1349,11 @@ void print_collected_amount( std::ostream& os, const player_t& p, const std::str
       name, sd.mean(),
       name, error, error * 100 / sd.mean(),
       name, ( sd.max() - sd.min() ) / 2.0, ( ( sd.max() - sd.min() ) / 2 ) * 100 / sd.mean() );
+
+  if ( sd.streaming )
+  {
+    fmt::print( os, "  {}-Median-Rank-Error={:.2f}% (streaming statistics)\n", name, sd.percentile_error( 0.5 ) * 100 );
+  }
 }
 
 void print_player( std::ostream& os, player_t& p )
@@ -1243,8 +1444,23 @@ void print_profilesets( std::ostream& out, const profileset::profilesets_t& prof
   auto results = profilesets.generate_sorted_profilesets();
 
   range::for_each( results, [ &out ]( const profileset::profile_set_t* profileset ) {
-    fmt::print( out, "    {:-10.3f} : {:s}\n", profileset->result().median(), profileset->name() );
+    if ( profileset->eliminated_round() > 0 )
+    {
+      fmt::print( out, "    {:-10.3f} : {:s} (eliminated in racing round {})\n", profileset->result().median(),
+                  profileset->name(), profileset->eliminated_round() );
+    }
+    else
+    {
+      fmt::print( out, "    {:-10.3f} : {:s}\n", profileset->result().median(), profileset->name() );
+    }
   } );
+
+  if ( profilesets.warm_reused() > 0 )
+  {
+    fmt::print( out, "\n  Warm sims reused: {} (validation init {:.3f}s, init saved {:.3f}s)\n",
+                profilesets.warm_reused(), chrono::to_fp_seconds( profilesets.validate_time() ),
+                chrono::to_fp_seconds( profilesets.saved_init_time() ) );
+  }
 }
 
 void print_text_report( std::ostream& os, sim_t* sim, bool detail )
@@ -1332,6 +1548,12 @@ void print_text_report( std::ostream& os, sim_t* sim, bool detail )
     print_raid_scale_factors( os, sim );
     print_reference_dps( os, *sim );
     print_event_manager_infos( os, *sim );
+    print_event_allocation( os, *sim );
+    print_action_state_infos( os, *sim );
+    print_sample_data_memory( os, *sim );
+    print_expression_benchmark( os, *sim );
+    print_name_index_benchmark( os, *sim );
+    print_apl_ready_cache( os, *sim );
 #ifndef NDEBUG
     print_truncated_guass_counts( os, *sim );
 #endif
@@ -315,6 +315,13 @@ int sim_t::main( const std::vector<std::string>& args )
       return 0;
     }
 
+    if ( !client_data_output.empty() )
+    {
+      dbc::write_client_data( client_data_output );
+      fmt::print( "Client data written to '{}'.\n", client_data_output );
+      return 0;
+    }
+
     if ( canceled )
     {
       return 1;
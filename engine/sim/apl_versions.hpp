@@ -0,0 +1,20 @@
+// ==========================================================================
+// Dedmonwakeen's Raid DPS/TPS Simulator.
+// Send questions to natehieter@gmail.com
+// ==========================================================================
+
+#pragma once
+
+#include <cstdint>
+
+// Change counters of the state APL line readiness depends on, only maintained with apl_ready_cache
+struct apl_versions_t
+{
+  uint64_t cooldown = 0, resource = 0, buff = 0, target = 0, variable = 0, execute = 0;
+
+  bool operator==( const apl_versions_t& o ) const
+  {
+    return cooldown == o.cooldown && resource == o.resource && buff == o.buff && target == o.target &&
+           variable == o.variable && execute == o.execute;
+  }
+};
@@ -88,6 +88,28 @@ struct ready_trigger_event_t : public event_t
   }
 };
 
+// cooldown.X.up and cooldown.X.remains, which compile into typed opcodes
+struct cooldown_expr_t : public expr_t
+{
+  const cooldown_t& cooldown;
+  expression::opcode_e opcode;
+
+  cooldown_expr_t( util::string_view name, const cooldown_t& cd, expression::opcode_e op ) :
+    expr_t( name ), cooldown( cd ), opcode( op )
+  { }
+
+  double evaluate() override
+  {
+    if ( opcode == expression::OP_COOLDOWN_UP )
+      return cooldown.up();
+    else
+      return cooldown.remains().total_seconds();
+  }
+
+  void compile( expression::program_t& program ) override
+  { program.leaf( opcode, &cooldown ); }
+};
+
 } // UNNAMED NAMESPACE
 
 cooldown_t::cooldown_t( util::string_view n, player_t& p ) :
@@ -518,7 +540,7 @@ timespan_t cooldown_t::cooldown_duration( const cooldown_t* cd )
 std::unique_ptr<expr_t> cooldown_t::create_expression( std::string_view name )
 {
   if ( name == "remains" )
-    return make_mem_fn_expr( "cooldown_remains", *this, &cooldown_t::remains );
+    return std::make_unique<cooldown_expr_t>( "cooldown_remains", *this, expression::OP_COOLDOWN_REMAINS );
   else if ( name == "base_duration" )
   {
     return make_fn_expr( "cooldown_base_duration", [ this ]
@@ -539,7 +561,7 @@ std::unique_ptr<expr_t> cooldown_t::create_expression( std::string_view name )
     } );
   }
   else if ( name == "up" || name == "ready" )
-    return make_mem_fn_expr( "cooldown_up", *this, &cooldown_t::up );
+    return std::make_unique<cooldown_expr_t>( "cooldown_up", *this, expression::OP_COOLDOWN_UP );
   else if ( name == "charges" )
   {
     return make_fn_expr( name, [ this ]
@@ -626,6 +648,9 @@ std::unique_ptr<expr_t> cooldown_t::create_expression( std::string_view name )
 
 void cooldown_t::update_ready_thresholds()
 {
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.cooldown++;
+
   if ( player == nullptr )
   {
     return;
@@ -697,6 +722,9 @@ void cooldown_t::set_max_charges( int new_max_charges )
 {
   assert( new_max_charges > 0 && "Cooldown charges must be greater than 0" );
 
+  if ( sim.apl_ready_cache )
+    sim.apl_versions.cooldown++;
+
   int charges_max = charges;
 
   // Charges are not being changed, just end.
@@ -7,6 +7,7 @@
 
 #include "config.hpp"
 
+#include "sim/event_manager.hpp"
 #include "util/timespan.hpp"
 #include "util/generic.hpp"
 #include "util/format.hpp"
@@ -39,7 +40,7 @@ constexpr unsigned next_power_of_two( unsigned v )
 // as such there are rules of use that must be honored:
 //
 // (1) The pure virtual execute() method MUST be implemented in the sub-class
-// (2) There is 1 * sizeof( event_t ) space available to extend the sub-class
+// (2) Sub-classes can be at most event_manager_t::MAX_EVENT_SIZE bytes
 // (3) event_manager_t is responsible for deleting the memory associated with allocated events
 // (4) create events through make_event method
 struct event_t : private noncopyable
@@ -120,8 +121,8 @@ inline Event* make_event( sim_t& sim, Args&&... args )
 {
   static_assert( std::is_base_of<event_t, Event>::value,
                  "Event must be derived from event_t" );
-  static_assert( sizeof( Event ) <= util::next_power_of_two( 2 * sizeof( event_t ) ),
-                 "Event type is too big" );
+  static_assert( sizeof( Event ) <= event_manager_t::MAX_EVENT_SIZE, "Event type is too big" );
+  static_assert( alignof( Event ) <= event_manager_t::EVENT_ALIGN, "Event type alignment is too big" );
   auto r = new ( sim ) Event( std::forward<Args>(args)... );
   assert( r -> id != 0 && "Event not added to event manager!" );
   return r;
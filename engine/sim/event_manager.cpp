@@ -9,6 +9,219 @@
 #include "sim/sim.hpp"
 #include "player/player.hpp"
 
+#include <algorithm>
+#include <new>
+
+namespace
+{
+constexpr unsigned NO_SLOT = ~0U;
+
+unsigned count_trailing_zeros( uint64_t v )
+{
+#if defined( SC_VS )
+  unsigned long idx;
+  _BitScanForward64( &idx, v );
+  return static_cast<unsigned>( idx );
+#else
+  return static_cast<unsigned>( __builtin_ctzll( v ) );
+#endif
+}
+
+// First occupied slot at or after slot index "from", or NO_SLOT
+unsigned find_occupied( const std::vector<uint64_t>& occupied, uint64_t from )
+{
+  auto word = from >> 6;
+  if ( word >= occupied.size() )
+    return NO_SLOT;
+
+  auto bits = occupied[ word ] & ( ~uint64_t( 0 ) << ( from & 63 ) );
+  while ( !bits )
+  {
+    if ( ++word == occupied.size() )
+      return NO_SLOT;
+
+    bits = occupied[ word ];
+  }
+
+  return static_cast<unsigned>( word * 64 + count_trailing_zeros( bits ) );
+}
+
+// Min-heap ordering on ( time, id ), i.e., the reference wheel execution order
+bool overflow_later( const event_t* l, const event_t* r )
+{
+  if ( l->time != r->time )
+    return l->time > r->time;
+
+  return l->id > r->id;
+}
+}  // namespace
+
+// hierarchical_wheel_t::hierarchical_wheel_t ===============================
+
+hierarchical_wheel_t::hierarchical_wheel_t() : levels(), overflow(), tick( 0 )
+{
+}
+
+// hierarchical_wheel_t::init ===============================================
+
+void hierarchical_wheel_t::init()
+{
+  unsigned shift = 0;
+  for ( unsigned i = 0; i < N_LEVELS; ++i )
+  {
+    auto& level = levels[ i ];
+    auto n_slots = uint64_t( 1 ) << LEVEL_BITS[ i ];
+
+    level.shift = shift;
+    level.mask  = n_slots - 1;
+    level.slots.assign( n_slots, slot_t{ nullptr, nullptr } );
+    level.occupied.assign( ( n_slots + 63 ) / 64, 0 );
+
+    shift += LEVEL_BITS[ i ];
+  }
+
+  overflow.reserve( 16 );
+}
+
+// hierarchical_wheel_t::clear ==============================================
+
+void hierarchical_wheel_t::clear()
+{
+  for ( auto& level : levels )
+  {
+    level.slots.assign( level.slots.size(), slot_t{ nullptr, nullptr } );
+    level.occupied.assign( level.occupied.size(), 0 );
+  }
+
+  overflow.clear();
+  tick = 0;
+}
+
+// hierarchical_wheel_t::append =============================================
+
+void hierarchical_wheel_t::append( level_t& level, uint64_t slot, event_t* e )
+{
+  auto& list = level.slots[ slot ];
+  if ( list.tail )
+  {
+    list.tail->next = e;
+  }
+  else
+  {
+    list.head = e;
+    level.occupied[ slot >> 6 ] |= uint64_t( 1 ) << ( slot & 63 );
+  }
+
+  list.tail = e;
+}
+
+// hierarchical_wheel_t::insert =============================================
+
+void hierarchical_wheel_t::insert( event_t* e )
+{
+  auto time = static_cast<uint64_t>( e->time.total_millis() );
+  assert( time >= tick && "Event inserted into the past of the timing wheel" );
+
+  // Place the event on the lowest level whose current block also holds the
+  // event, i.e., the level of the highest bit that differs from the tick.
+  for ( unsigned i = 0; i < N_LEVELS; ++i )
+  {
+    auto& level      = levels[ i ];
+    auto block_shift = level.shift + LEVEL_BITS[ i ];
+    if ( ( time >> block_shift ) == ( tick >> block_shift ) )
+    {
+      append( level, ( time >> level.shift ) & level.mask, e );
+      return;
+    }
+  }
+
+  overflow.push_back( e );
+  std::push_heap( overflow.begin(), overflow.end(), overflow_later );
+}
+
+// hierarchical_wheel_t::cascade ============================================
+
+void hierarchical_wheel_t::cascade( level_t& level, uint64_t slot )
+{
+  auto& list = level.slots[ slot ];
+  event_t* e = list.head;
+
+  list = slot_t{ nullptr, nullptr };
+  level.occupied[ slot >> 6 ] &= ~( uint64_t( 1 ) << ( slot & 63 ) );
+
+  // Re-inserting in list order keeps same-time events in id order
+  while ( e )
+  {
+    event_t* next = e->next;
+    e->next       = nullptr;
+    insert( e );
+    e = next;
+  }
+}
+
+// hierarchical_wheel_t::next ===============================================
+
+event_t* hierarchical_wheel_t::next()
+{
+  while ( true )
+  {
+    // Level 0 has millisecond slots, so its first occupied slot at or after the
+    // tick holds the next event(s) to execute.
+    auto& base = levels[ 0 ];
+    auto slot = find_occupied( base.occupied, tick & base.mask );
+    if ( slot != NO_SLOT )
+    {
+      auto& list = base.slots[ slot ];
+      event_t* e = list.head;
+      list.head  = e->next;
+      if ( !list.head )
+      {
+        list.tail = nullptr;
+        base.occupied[ slot >> 6 ] &= ~( uint64_t( 1 ) << ( slot & 63 ) );
+      }
+
+      tick = ( tick & ~base.mask ) | slot;
+      return e;
+    }
+
+    // Current level 0 block is exhausted, advance the tick to the next occupied
+    // slot of the lowest possible upper level and cascade it down.
+    bool cascaded = false;
+    for ( unsigned i = 1; i < N_LEVELS && !cascaded; ++i )
+    {
+      auto& level = levels[ i ];
+      slot = find_occupied( level.occupied, ( ( tick >> level.shift ) & level.mask ) + 1 );
+      if ( slot == NO_SLOT )
+        continue;
+
+      auto block_mask = ( level.mask << level.shift ) | ( ( uint64_t( 1 ) << level.shift ) - 1 );
+      tick = ( tick & ~block_mask ) | ( uint64_t( slot ) << level.shift );
+      cascade( level, slot );
+      cascaded = true;
+    }
+
+    if ( cascaded )
+      continue;
+
+    // Whole wheel is empty, pull the next block of far-future events in
+    if ( overflow.empty() )
+      return nullptr;
+
+    const auto& top = levels.back();
+    auto block_shift = top.shift + LEVEL_BITS.back();
+    tick = ( static_cast<uint64_t>( overflow.front()->time.total_millis() ) >> block_shift ) << block_shift;
+
+    while ( !overflow.empty() &&
+            ( static_cast<uint64_t>( overflow.front()->time.total_millis() ) >> block_shift ) == ( tick >> block_shift ) )
+    {
+      std::pop_heap( overflow.begin(), overflow.end(), overflow_later );
+      event_t* e = overflow.back();
+      overflow.pop_back();
+      insert( e );
+    }
+  }
+}
+
 
 event_manager_t::event_manager_t( sim_t* s )
   : sim( s ),
@@ -20,25 +233,29 @@ event_manager_t::event_manager_t( sim_t* s )
     global_event_id( 1 ),  // start at 1, so we can identify event -> id == 0
                            // meaning a unscheduled event.
     timing_wheel(),
-    recycled_event_list( nullptr ),
+    event_pools(),
+    event_slabs(),
     wheel_seconds( 0 ),
     wheel_size( 0 ),
     wheel_mask( 0 ),
     wheel_shift( 5 ),
     wheel_granularity( 0.0 ),
     wheel_time( timespan_t::zero() ),
+    hierarchical( false ),
+    hwheel(),
     event_stopwatch(),
-#ifdef EVENT_QUEUE_DEBUG
     monitor_cpu( false ),
+    canceled( false ),
+    collect_size_histogram( false ),
+    n_requested_events( 0 ),
+    event_requested_size_count()
+#ifdef EVENT_QUEUE_DEBUG
+    ,
     max_queue_depth( 0 ),
     n_allocated_events( 0 ),
-    n_requested_events( 0 ),
     n_end_insert( 0 ),
     events_traversed( 0 ),
     events_added( 0 )
-#else
-    monitor_cpu( false ),
-    canceled( false )
 #endif /* EVENT_QUEUE_DEBUG */
 {
   allocated_events.reserve( 100 );
@@ -48,49 +265,67 @@ event_manager_t::event_manager_t( sim_t* s )
 
 event_manager_t::~event_manager_t()
 {
-  while ( recycled_event_list )
+  for ( auto slab : event_slabs )
   {
-    event_t* e          = recycled_event_list;
-    recycled_event_list = e->next;
-    free( e );
+    ::operator delete( slab, std::align_val_t( EVENT_SLAB_SIZE ) );
   }
 }
 
+// event_manager_t::allocate_slab ===========================================
+
+void event_manager_t::allocate_slab( std::size_t size_class )
+{
+  auto slab = static_cast<char*>( ::operator new( EVENT_SLAB_SIZE, std::align_val_t( EVENT_SLAB_SIZE ) ) );
+  event_slabs.push_back( slab );
+
+  // The first cache line of the slab identifies the size class of the events in it
+  *reinterpret_cast<std::size_t*>( slab ) = size_class;
+
+  auto& pool = event_pools[ size_class ];
+  pool.cursor = slab + EVENT_ALIGN;
+  pool.end    = slab + EVENT_SLAB_SIZE;
+  pool.n_slabs++;
+}
+
 // event_manager_t::allocate_event ==========================================
 
-void* event_manager_t::allocate_event( [[maybe_unused]] const std::size_t size )
+void* event_manager_t::allocate_event( const std::size_t size )
 {
-  static constexpr std::size_t SIZE = util::next_power_of_two( 2 * sizeof( event_t ) );
-  assert( size <= SIZE );
+  assert( size <= MAX_EVENT_SIZE );
 
-  event_t* e = recycled_event_list;
-#ifdef EVENT_QUEUE_DEBUG
-  n_requested_events++;
-  if ( size >= event_requested_size_count.size() )
+  if ( collect_size_histogram )
   {
-    event_requested_size_count.resize( size + 1 );
+    n_requested_events++;
+    if ( size >= event_requested_size_count.size() )
+    {
+      event_requested_size_count.resize( size + 1 );
+    }
+    event_requested_size_count[ size ]++;
   }
-  event_requested_size_count[ size ]++;
-#endif
+
+  auto cls   = size_class( size );
+  auto& pool = event_pools[ cls ];
+
+  event_t* e = pool.recycled;
   if ( e )
   {
-    recycled_event_list = e->next;
+    pool.recycled = e->next;
   }
   else
   {
-    e = (event_t*)malloc( SIZE );
-
-    if ( !e )
+    const auto block = ( cls + 1 ) * EVENT_ALIGN;
+    if ( static_cast<std::size_t>( pool.end - pool.cursor ) < block )
     {
-      throw std::bad_alloc();
+      allocate_slab( cls );
     }
-    else
-    {
+
+    e = reinterpret_cast<event_t*>( pool.cursor );
+    pool.cursor += block;
+    pool.n_allocated++;
 #ifdef EVENT_QUEUE_DEBUG
-      n_allocated_events++;
+    n_allocated_events++;
 #endif
-      allocated_events.push_back( e );
-    }
+    allocated_events.push_back( e );
   }
 
   return e;
@@ -100,10 +335,13 @@ void* event_manager_t::allocate_event( [[maybe_unused]] const std::size_t size )
 
 void event_manager_t::recycle_event( event_t* e )
 {
+  auto slab  = reinterpret_cast<std::uintptr_t>( e ) & ~( EVENT_SLAB_SIZE - 1 );
+  auto& pool = event_pools[ *reinterpret_cast<const std::size_t*>( slab ) ];
+
   e->~event_t();
-  e->recycled         = true;
-  e->next             = recycled_event_list;
-  recycled_event_list = e;
+  e->recycled   = true;
+  e->next       = pool.recycled;
+  pool.recycled = e;
 }
 
 // event_manager_t::add_event ===============================================
@@ -127,49 +365,56 @@ void event_manager_t::add_event( event_t* e, timespan_t delta_time )
     e->reschedule_time = timespan_t::zero();
   }
 
-  // Determine the timing wheel position to which the event will belong
-  // Only valid for integer based timespan_t
-  uint32_t slice = static_cast<uint32_t>(
-      ( e->time.total_millis() >> wheel_shift ) & wheel_mask );
+  if ( hierarchical )
+  {
+    hwheel.insert( e );
+  }
+  else
+  {
+    // Determine the timing wheel position to which the event will belong
+    // Only valid for integer based timespan_t
+    uint32_t slice = static_cast<uint32_t>(
+        ( e->time.total_millis() >> wheel_shift ) & wheel_mask );
 
-  // Insert event into the event list at the appropriate time
-  event_t** prev = &( timing_wheel[ slice ] );
+    // Insert event into the event list at the appropriate time
+    event_t** prev = &( timing_wheel[ slice ] );
 #ifdef EVENT_QUEUE_DEBUG
-  unsigned traversed = 0;
+    unsigned traversed = 0;
 #endif
 
-  while ( ( *prev ) &&
-          ( *prev )->time <= e->time )  // Find position in the list
-  {
-    prev = &( ( *prev )->next );
+    while ( ( *prev ) &&
+            ( *prev )->time <= e->time )  // Find position in the list
+    {
+      prev = &( ( *prev )->next );
 #ifdef EVENT_QUEUE_DEBUG
-    traversed++;
+      traversed++;
 #endif
-  }
+    }
 #ifdef EVENT_QUEUE_DEBUG
-  events_added++;
-  events_traversed += traversed;
-  if ( traversed > max_queue_depth )
-  {
-    max_queue_depth = traversed;
-  }
-  if ( traversed >= event_queue_depth_samples.size() )
-  {
-    event_queue_depth_samples.resize( traversed + 1 );
-  }
-  event_queue_depth_samples[ traversed ].first++;
-  if ( !(*prev) )
-  {
-    event_queue_depth_samples[ traversed ].second++;
-    if ( traversed )
+    events_added++;
+    events_traversed += traversed;
+    if ( traversed > max_queue_depth )
     {
-      n_end_insert++;
+      max_queue_depth = traversed;
+    }
+    if ( traversed >= event_queue_depth_samples.size() )
+    {
+      event_queue_depth_samples.resize( traversed + 1 );
+    }
+    event_queue_depth_samples[ traversed ].first++;
+    if ( !(*prev) )
+    {
+      event_queue_depth_samples[ traversed ].second++;
+      if ( traversed )
+      {
+        n_end_insert++;
+      }
     }
-  }
 #endif
-  // insert event
-  e->next = *prev;
-  *prev   = e;
+    // insert event
+    e->next = *prev;
+    *prev   = e;
+  }
 
   if ( ++events_remaining > max_events_remaining )
     max_events_remaining = events_remaining;
@@ -312,13 +557,28 @@ void event_manager_t::flush()
   }
 
   // Clear Timing Wheel
-  timing_wheel.assign( timing_wheel.size(), nullptr );
+  if ( hierarchical )
+    hwheel.clear();
+  else
+    timing_wheel.assign( timing_wheel.size(), nullptr );
 }
 
 // event_manager_t::init ====================================================
 
 void event_manager_t::init()
 {
+  // The reference wheel is not allocated at all in hierarchical mode, as it
+  // would be sized for wheel_seconds, which may then be set much larger.
+  if ( hierarchical )
+  {
+    if ( wheel_seconds < 1024 )
+      wheel_seconds = 1024;
+
+    wheel_time = timespan_t::from_seconds( wheel_seconds );
+    hwheel.init();
+    return;
+  }
+
   // Timing wheel depth defaults to about 17 minutes with a granularity of 32
   // buckets per second.
   // This makes wheel_size = 32K and it's fully used.
@@ -353,6 +613,15 @@ event_t* event_manager_t::next_event()
   if ( events_remaining == 0 )
     return nullptr;
 
+  if ( hierarchical )
+  {
+    event_t* e = hwheel.next();
+    assert( e && "Hierarchical timing wheel out of sync with events_remaining" );
+    events_remaining--;
+    events_processed++;
+    return e;
+  }
+
   while ( true )
   {
     event_t*& event_list = timing_wheel[ timing_slice ];
@@ -386,6 +655,9 @@ void event_manager_t::reset()
   global_event_id  = 0;
   canceled         = false;
   current_time     = timespan_t::zero();
+
+  if ( hierarchical )
+    hwheel.clear();
 }
 
 // event_manager_t::merge ===================================================
@@ -395,12 +667,27 @@ void event_manager_t::merge( event_manager_t& other )
   max_events_remaining =
       std::max( max_events_remaining, other.max_events_remaining );
   total_events_processed += other.total_events_processed;
+
+  n_requested_events += other.n_requested_events;
+  if ( other.event_requested_size_count.size() > event_requested_size_count.size() )
+  {
+    event_requested_size_count.resize( other.event_requested_size_count.size() );
+  }
+  for ( size_t i = 0; i < other.event_requested_size_count.size(); ++i )
+  {
+    event_requested_size_count[ i ] += other.event_requested_size_count[ i ];
+  }
+
+  for ( size_t i = 0; i < event_pools.size(); ++i )
+  {
+    event_pools[ i ].n_slabs += other.event_pools[ i ].n_slabs;
+    event_pools[ i ].n_allocated += other.event_pools[ i ].n_allocated;
+  }
 #ifdef EVENT_QUEUE_DEBUG
   events_traversed += other.events_traversed;
   events_added += other.events_added;
   n_allocated_events += other.n_allocated_events;
   n_end_insert += other.n_end_insert;
-  n_requested_events += other.n_requested_events;
   if ( other.max_queue_depth > max_queue_depth )
   {
     max_queue_depth = other.max_queue_depth;
@@ -419,11 +706,6 @@ void event_manager_t::merge( event_manager_t& other )
     event_queue_depth_samples[ i ].second +=
         other.event_queue_depth_samples[ i ].second;
   }
-  for ( size_t i = 0; i < other.event_requested_size_count.size(); ++i )
-  {
-    event_requested_size_count[ i ] += other.event_requested_size_count[ i ];
-  }
-
 #endif
 }
 
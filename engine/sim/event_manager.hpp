@@ -11,15 +11,79 @@
 #include "util/stopwatch.hpp"
 #include "util/timespan.hpp"
 
+#include <array>
 #include <cstdint>
 #include <vector>
 
 struct event_t;
 struct sim_t;
 
+// Hierarchical timing wheel ================================================
+//
+// Multi-level timing wheel used instead of the single-level reference wheel
+// when wheel_hierarchical=1. Each level is an array of FIFO event lists
+// covering aligned blocks of time: level 0 has one slot per millisecond, and
+// each higher level has one slot per full block of the level below it. An
+// event is placed on the lowest level whose block also contains the current
+// tick, so insertion is O(1), and lists are cascaded down one level whenever
+// the tick enters a new block. Events past the highest level are kept in a
+// small (time, id) ordered min-heap until the tick reaches them.
+//
+// Lists are appended to in event id order, so events that occur at the same
+// time execute in the same order as in the reference wheel.
+struct hierarchical_wheel_t
+{
+  static constexpr unsigned N_LEVELS = 3;
+  static constexpr std::array<unsigned, N_LEVELS> LEVEL_BITS = { { 8, 6, 6 } };
+
+  struct slot_t
+  {
+    event_t* head;
+    event_t* tail;
+  };
+
+  struct level_t
+  {
+    unsigned shift;
+    uint64_t mask;
+    std::vector<slot_t> slots;
+    std::vector<uint64_t> occupied;
+  };
+
+  std::array<level_t, N_LEVELS> levels;
+  std::vector<event_t*> overflow;
+  uint64_t tick;
+
+  hierarchical_wheel_t();
+  void init();
+  void clear();
+  void insert( event_t* );
+  event_t* next();
+
+private:
+  void append( level_t&, uint64_t slot, event_t* );
+  void cascade( level_t&, uint64_t slot );
+};
+
 // Event manager
 struct event_manager_t
 {
+  // Events are allocated in cache line sized size classes from cache line aligned slabs. Each slab
+  // only holds events of one size class, which is stored in the first cache line of the slab.
+  static constexpr std::size_t EVENT_ALIGN     = 64;
+  static constexpr std::size_t MAX_EVENT_SIZE  = 1024;
+  static constexpr std::size_t N_EVENT_CLASSES = MAX_EVENT_SIZE / EVENT_ALIGN;
+  static constexpr std::size_t EVENT_SLAB_SIZE = 65536;
+
+  struct event_pool_t
+  {
+    event_t* recycled;
+    char* cursor;
+    char* end;
+    unsigned n_slabs;
+    uint64_t n_allocated;
+  };
+
   sim_t* sim;
   timespan_t current_time;
   uint64_t events_remaining;
@@ -28,20 +92,25 @@ struct event_manager_t
   uint64_t max_events_remaining;
   unsigned timing_slice, global_event_id;
   std::vector<event_t*> timing_wheel;
-  event_t* recycled_event_list;
+  std::array<event_pool_t, N_EVENT_CLASSES> event_pools;
+  std::vector<void*> event_slabs;
   int wheel_seconds, wheel_size, wheel_mask, wheel_shift;
   double wheel_granularity;
   timespan_t wheel_time;
   std::vector<event_t*> allocated_events;
+  bool hierarchical;
+  hierarchical_wheel_t hwheel;
 
   stopwatch_t<chrono::thread_clock> event_stopwatch;
   bool monitor_cpu;
   bool canceled;
+  bool collect_size_histogram;
+  uint64_t n_requested_events;
+  std::vector<uint64_t> event_requested_size_count;
 #ifdef EVENT_QUEUE_DEBUG
-  unsigned max_queue_depth, n_allocated_events, n_end_insert, n_requested_events;
+  unsigned max_queue_depth, n_allocated_events, n_end_insert;
   uint64_t events_traversed, events_added;
   std::vector<std::pair<unsigned, unsigned> > event_queue_depth_samples;
-  std::vector<unsigned> event_requested_size_count;
 #endif /* EVENT_QUEUE_DEBUG */
 
   event_manager_t( sim_t* );
@@ -58,4 +127,10 @@ struct event_manager_t
   void reset();
   void merge( event_manager_t& other );
   void cancel_stuck( std::vector<std::string>& debug_list );
+
+  static constexpr std::size_t size_class( std::size_t size )
+  { return ( size + EVENT_ALIGN - 1 ) / EVENT_ALIGN - 1; }
+
+private:
+  void allocate_slab( std::size_t size_class );
 };
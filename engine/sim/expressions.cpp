@@ -5,8 +5,11 @@
 
 #include "expressions.hpp"
 #include "action/action.hpp"
+#include "buff/buff.hpp"
 #include "player/player.hpp"
+#include "sim/cooldown.hpp"
 #include "sim/sim.hpp"
+#include "util/chrono.hpp"
 #include <atomic>
 
 namespace expression
@@ -160,6 +163,12 @@ public:
   {
     return F()( input->eval() );
   }
+
+  void compile( program_t& program ) override
+  {
+    input->compile( program );
+    program.unary( op_ );
+  }
 };
 
 namespace unary
@@ -268,6 +277,14 @@ public:
   {
     return left->eval() && right->eval();
   }
+
+  void compile( program_t& program ) override
+  {
+    left->compile( program );
+    auto jump = program.jump( TOK_AND );
+    right->compile( program );
+    program.patch( jump );
+  }
 };
 
 class logical_or_t : public binary_base_t
@@ -282,6 +299,14 @@ public:
   {
     return left->eval() || right->eval();
   }
+
+  void compile( program_t& program ) override
+  {
+    left->compile( program );
+    auto jump = program.jump( TOK_OR );
+    right->compile( program );
+    program.patch( jump );
+  }
 };
 
 class logical_xor_t : public binary_base_t
@@ -296,6 +321,13 @@ public:
   {
     return bool( left->eval() != 0 ) != bool( right->eval() != 0 );
   }
+
+  void compile( program_t& program ) override
+  {
+    left->compile( program );
+    right->compile( program );
+    program.binary( op_ );
+  }
 };
 
 template <template <typename> class F, typename T = double>
@@ -311,6 +343,13 @@ public:
   {
     return static_cast<double>( F<T>()( static_cast<T>( left->eval() ), static_cast<T>( right->eval() ) ) );
   }
+
+  void compile( program_t& program ) override
+  {
+    left->compile( program );
+    right->compile( program );
+    program.binary( op_ );
+  }
 };
 
 std::unique_ptr<expr_t> select_binary( util::string_view name, token_e op, std::unique_ptr<expr_t> left,
@@ -523,6 +562,13 @@ struct left_reduced_t : public expr_t
   {
     return static_cast<double>( F<T>()( static_cast<T>( left ), static_cast<T>( right->eval() ) ) );
   }
+
+  void compile( program_t& program ) override
+  {
+    program.constant( left );
+    right->compile( program );
+    program.binary( op_ );
+  }
 };
 
 template <template <typename> class F, typename T = double>
@@ -555,6 +601,13 @@ struct right_reduced_t : public expr_t
   {
     return static_cast<double>( F<T>()( static_cast<T>( left->eval() ), static_cast<T>( right ) ) );
   }
+
+  void compile( program_t& program ) override
+  {
+    left->compile( program );
+    program.constant( right );
+    program.binary( op_ );
+  }
 };
 class analyze_logical_and_t : public analyze_binary_base_t
 {
@@ -1281,6 +1334,204 @@ std::unique_ptr<expr_t> build_player_expression_tree(
   return res;
 }
 
+// program_t ================================================================
+
+program_t::program_t() : code(), depth( 0 ), max_depth( 0 ), ok( true )
+{
+}
+
+void program_t::push( opcode_e op, int stack_change )
+{
+  code.emplace_back();
+  code.back().op = op;
+  depth += stack_change;
+  max_depth = std::max( max_depth, depth );
+}
+
+void program_t::constant( double value )
+{
+  push( OP_CONST, 1 );
+  code.back().value = value;
+}
+
+void program_t::load( const double* value )
+{
+  leaf( OP_LOAD_DOUBLE, value );
+}
+
+void program_t::load( const int* value )
+{
+  leaf( OP_LOAD_INT, value );
+}
+
+void program_t::leaf( opcode_e op, const void* object )
+{
+  push( op, 1 );
+  code.back().ptr = object;
+}
+
+void program_t::call( expr_t* expr )
+{
+  push( OP_CALL, 1 );
+  code.back().expr = expr;
+}
+
+void program_t::unary( token_e op )
+{
+  switch ( op )
+  {
+    case TOK_PLUS:  return;
+    case TOK_MINUS: push( OP_NEG, 0 ); break;
+    case TOK_NOT:   push( OP_NOT, 0 ); break;
+    case TOK_ABS:   push( OP_ABS, 0 ); break;
+    case TOK_FLOOR: push( OP_FLOOR, 0 ); break;
+    case TOK_CEIL:  push( OP_CEIL, 0 ); break;
+    default:        ok = false; break;
+  }
+}
+
+void program_t::binary( token_e op )
+{
+  switch ( op )
+  {
+    case TOK_ADD:   push( OP_ADD, -1 ); break;
+    case TOK_SUB:   push( OP_SUB, -1 ); break;
+    case TOK_MULT:  push( OP_MUL, -1 ); break;
+    case TOK_DIV:   push( OP_DIV, -1 ); break;
+    case TOK_MOD:   push( OP_MOD, -1 ); break;
+    case TOK_MAX:   push( OP_MAX, -1 ); break;
+    case TOK_MIN:   push( OP_MIN, -1 ); break;
+    case TOK_EQ:    push( OP_EQ, -1 ); break;
+    case TOK_NOTEQ: push( OP_NOTEQ, -1 ); break;
+    case TOK_LT:    push( OP_LT, -1 ); break;
+    case TOK_LTEQ:  push( OP_LTEQ, -1 ); break;
+    case TOK_GT:    push( OP_GT, -1 ); break;
+    case TOK_GTEQ:  push( OP_GTEQ, -1 ); break;
+    case TOK_AND:   push( OP_AND, -1 ); break;
+    case TOK_OR:    push( OP_OR, -1 ); break;
+    case TOK_XOR:   push( OP_XOR, -1 ); break;
+    default:        ok = false; break;
+  }
+}
+
+size_t program_t::jump( token_e op )
+{
+  if ( op != TOK_AND && op != TOK_OR )
+  {
+    ok = false;
+  }
+
+  // Stack depth is tracked for the fall-through path, where the left hand side is popped
+  push( op == TOK_AND ? OP_AND_JUMP : OP_OR_JUMP, -1 );
+  return code.size() - 1;
+}
+
+void program_t::patch( size_t jump )
+{
+  push( OP_BOOL, 0 );
+  code[ jump ].target = code.size();
+}
+
+double program_t::evaluate() const
+{
+  double stack[ MAX_STACK ];
+  double* top = stack - 1;
+
+  const instruction_t* begin = code.data();
+  const instruction_t* end   = begin + code.size();
+  for ( const instruction_t* ip = begin; ip != end; ++ip )
+  {
+    switch ( ip->op )
+    {
+      case OP_CONST:
+        *++top = ip->value;
+        break;
+      case OP_LOAD_DOUBLE:
+        *++top = *static_cast<const double*>( ip->ptr );
+        break;
+      case OP_LOAD_INT:
+        *++top = *static_cast<const int*>( ip->ptr );
+        break;
+      case OP_CALL:
+        *++top = ip->expr->eval();
+        break;
+      case OP_BUFF_UP:
+        *++top = static_cast<const buff_t*>( ip->ptr )->check() > 0;
+        break;
+      case OP_BUFF_DOWN:
+        *++top = static_cast<const buff_t*>( ip->ptr )->check() <= 0;
+        break;
+      case OP_BUFF_STACK:
+        *++top = static_cast<const buff_t*>( ip->ptr )->check();
+        break;
+      case OP_BUFF_REMAINS:
+        *++top = static_cast<const buff_t*>( ip->ptr )->remains().total_seconds();
+        break;
+      case OP_COOLDOWN_UP:
+      {
+        auto cd = static_cast<const cooldown_t*>( ip->ptr );
+        *++top  = cd->ready <= cd->sim.current_time();
+        break;
+      }
+      case OP_COOLDOWN_REMAINS:
+      {
+        auto cd = static_cast<const cooldown_t*>( ip->ptr );
+        *++top  = std::max( timespan_t::zero(), cd->ready - cd->sim.current_time() ).total_seconds();
+        break;
+      }
+
+      case OP_NEG:   *top = -*top; break;
+      case OP_NOT:   *top = !*top; break;
+      case OP_ABS:   *top = std::fabs( *top ); break;
+      case OP_FLOOR: *top = std::floor( *top ); break;
+      case OP_CEIL:  *top = std::ceil( *top ); break;
+      case OP_BOOL:  *top = *top != 0; break;
+
+      case OP_ADD:   top[ -1 ] = top[ -1 ] + top[ 0 ]; --top; break;
+      case OP_SUB:   top[ -1 ] = top[ -1 ] - top[ 0 ]; --top; break;
+      case OP_MUL:   top[ -1 ] = top[ -1 ] * top[ 0 ]; --top; break;
+      case OP_DIV:   top[ -1 ] = top[ -1 ] / top[ 0 ]; --top; break;
+      case OP_MOD:   top[ -1 ] = std::fmod( top[ -1 ], top[ 0 ] ); --top; break;
+      case OP_MAX:   top[ -1 ] = std::max( top[ -1 ], top[ 0 ] ); --top; break;
+      case OP_MIN:   top[ -1 ] = std::min( top[ -1 ], top[ 0 ] ); --top; break;
+      case OP_EQ:    top[ -1 ] = top[ -1 ] == top[ 0 ]; --top; break;
+      case OP_NOTEQ: top[ -1 ] = top[ -1 ] != top[ 0 ]; --top; break;
+      case OP_LT:    top[ -1 ] = top[ -1 ] < top[ 0 ]; --top; break;
+      case OP_LTEQ:  top[ -1 ] = top[ -1 ] <= top[ 0 ]; --top; break;
+      case OP_GT:    top[ -1 ] = top[ -1 ] > top[ 0 ]; --top; break;
+      case OP_GTEQ:  top[ -1 ] = top[ -1 ] >= top[ 0 ]; --top; break;
+      case OP_AND:   top[ -1 ] = top[ -1 ] != 0 && top[ 0 ] != 0; --top; break;
+      case OP_OR:    top[ -1 ] = top[ -1 ] != 0 || top[ 0 ] != 0; --top; break;
+      case OP_XOR:   top[ -1 ] = ( top[ -1 ] != 0 ) != ( top[ 0 ] != 0 ); --top; break;
+
+      case OP_AND_JUMP:
+        if ( *top == 0 )
+        {
+          *top = 0;
+          ip   = begin + ip->target - 1;
+        }
+        else
+        {
+          --top;
+        }
+        break;
+      case OP_OR_JUMP:
+        if ( *top != 0 )
+        {
+          *top = 1;
+          ip   = begin + ip->target - 1;
+        }
+        else
+        {
+          --top;
+        }
+        break;
+    }
+  }
+
+  return *top;
+}
+
 }  // expression
 
 #if !defined( NDEBUG )
@@ -1368,6 +1619,8 @@ void expr_t::optimize_expression( std::unique_ptr<expr_t>& expression, sim_t& si
   }
   if ( sim.optimize_expressions - 1 - iterations < 0 )
   {
+    // Optimization is done, the final tree can be lowered into bytecode
+    compile_expression( expression, sim );
     return;
   }
   bool analyze_further = sim.optimize_expressions - 1 - iterations  > 0;
@@ -1378,6 +1631,114 @@ void expr_t::optimize_expression( std::unique_ptr<expr_t>& expression, sim_t& si
   }
 }
 
+// compiled_expr_t ==========================================================
+
+namespace
+{
+// Evaluates the bytecode program of an optimized expression tree. The tree is kept alive, since the
+// program calls into its leaves that do not have a typed opcode.
+class compiled_expr_t : public expr_t
+{
+protected:
+  std::unique_ptr<expr_t> tree;
+  expression::program_t program;
+
+public:
+  compiled_expr_t( std::unique_ptr<expr_t> t, expression::program_t p )
+    : expr_t( t->name(), t->op_ ), tree( std::move( t ) ), program( std::move( p ) )
+  {
+  }
+
+  double evaluate() override
+  {
+    return program.evaluate();
+  }
+
+  bool is_constant() override
+  {
+    return tree->is_constant();
+  }
+
+  bool is_compiled() override
+  {
+    return true;
+  }
+};
+
+// Evaluates both the tree and the program expression_benchmark times at every evaluation, and
+// accumulates the time spent in each form into the sim.
+class benchmark_expr_t final : public compiled_expr_t
+{
+  sim_t& sim;
+
+public:
+  benchmark_expr_t( sim_t& s, std::unique_ptr<expr_t> t, expression::program_t p )
+    : compiled_expr_t( std::move( t ), std::move( p ) ), sim( s )
+  {
+  }
+
+  double evaluate() override
+  {
+    auto n = sim.expression_benchmark;
+
+    double tree_result = 0;
+    auto start         = chrono::thread_clock::now();
+    for ( int i = 0; i < n; ++i )
+    {
+      tree_result = tree->eval();
+    }
+    sim.expression_benchmark_tree_time += chrono::elapsed_fp_seconds( start );
+
+    double result = 0;
+    start         = chrono::thread_clock::now();
+    for ( int i = 0; i < n; ++i )
+    {
+      result = program.evaluate();
+    }
+    sim.expression_benchmark_program_time += chrono::elapsed_fp_seconds( start );
+
+    sim.expression_benchmark_evaluations += n;
+    if ( result != tree_result && !( std::isnan( result ) && std::isnan( tree_result ) ) )
+    {
+      sim.expression_benchmark_mismatches++;
+    }
+
+    return result;
+  }
+};
+}  // namespace
+
+void expr_t::compile( expression::program_t& program )
+{
+  program.call( this );
+}
+
+void expr_t::compile_expression( std::unique_ptr<expr_t>& expression, sim_t& sim )
+{
+  if ( !expression || !sim.compile_expressions || expression->is_compiled() || expression->op_ == expression::TOK_NUM )
+  {
+    return;
+  }
+
+  expression::program_t program;
+  expression->compile( program );
+
+  // Programs that consist of a single call are not any faster than the tree
+  if ( !program.valid() || ( program.trivial() && !sim.expression_benchmark ) )
+  {
+    return;
+  }
+
+  if ( sim.expression_benchmark )
+  {
+    expression = std::make_unique<benchmark_expr_t>( sim, std::move( expression ), std::move( program ) );
+  }
+  else
+  {
+    expression = std::make_unique<compiled_expr_t>( std::move( expression ), std::move( program ) );
+  }
+}
+
 // action_expr_t::create_constant ===========================================
 
 // action_expr_t::parse =====================================================
@@ -6,10 +6,12 @@
 #pragma once
 
 #include "config.hpp"
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <functional>
 #include <memory>
+#include <type_traits>
 
 #include "util/timespan.hpp"
 #include "util/span.hpp"
@@ -73,6 +75,106 @@ bool convert_to_rpn( std::vector<expr_token_t>& tokens );
 std::unique_ptr<expr_t> build_player_expression_tree(
     player_t& player, std::vector<expression::expr_token_t>& tokens,
     bool optimize );
+
+// Bytecode =================================================================
+
+enum opcode_e : uint8_t
+{
+  // Leaves, push a value
+  OP_CONST,
+  OP_LOAD_DOUBLE,
+  OP_LOAD_INT,
+  OP_CALL,
+  OP_BUFF_UP,
+  OP_BUFF_DOWN,
+  OP_BUFF_STACK,
+  OP_BUFF_REMAINS,
+  OP_COOLDOWN_UP,
+  OP_COOLDOWN_REMAINS,
+
+  // Unary operators, replace the top of the stack
+  OP_NEG,
+  OP_NOT,
+  OP_ABS,
+  OP_FLOOR,
+  OP_CEIL,
+  OP_BOOL,
+
+  // Binary operators, pop two values and push the result
+  OP_ADD,
+  OP_SUB,
+  OP_MUL,
+  OP_DIV,
+  OP_MOD,
+  OP_MAX,
+  OP_MIN,
+  OP_EQ,
+  OP_NOTEQ,
+  OP_LT,
+  OP_LTEQ,
+  OP_GT,
+  OP_GTEQ,
+  OP_AND,
+  OP_OR,
+  OP_XOR,
+
+  // Short-circuiting logical operators, jump over the right hand side if the top of the stack
+  // decides the result
+  OP_AND_JUMP,
+  OP_OR_JUMP,
+};
+
+// Flat stack machine program that an optimized expression tree is lowered into, see
+// expr_t::compile(). Evaluating the program gives the same result as evaluating the tree, without
+// the virtual call per node. Leaves that do not have a typed opcode are called through the tree.
+class program_t
+{
+public:
+  static constexpr unsigned MAX_STACK = 64;
+
+private:
+  struct instruction_t
+  {
+    opcode_e op;
+    union
+    {
+      double value;
+      const void* ptr;
+      expr_t* expr;
+      size_t target;
+    };
+  };
+
+  std::vector<instruction_t> code;
+  unsigned depth, max_depth;
+  bool ok;
+
+  void push( opcode_e op, int stack_change );
+
+public:
+  program_t();
+
+  void constant( double value );
+  void load( const double* value );
+  void load( const int* value );
+  void leaf( opcode_e op, const void* object );
+  void call( expr_t* expr );
+  void unary( token_e op );
+  void binary( token_e op );
+  // Emits a short-circuit jump for TOK_AND or TOK_OR. After the right hand side has been emitted,
+  // patch() converts it to a boolean and points the jump past it.
+  size_t jump( token_e op );
+  void patch( size_t jump );
+
+  bool valid() const
+  { return ok && depth == 1 && max_depth <= MAX_STACK; }
+
+  // Program is a single call into the tree
+  bool trivial() const
+  { return code.size() == 1 && code.front().op == OP_CALL; }
+
+  double evaluate() const;
+};
 }
 
 /// Action expression
@@ -151,6 +253,13 @@ public:
 
   static void optimize_expression(std::unique_ptr<expr_t>& expression, sim_t& sim);
 
+  /// Replace a fully optimized expression with its bytecode compiled form
+  static void compile_expression( std::unique_ptr<expr_t>& expression, sim_t& sim );
+
+  /// Lower the expression into the program. Expressions without a cheaper form are evaluated
+  /// through a virtual call.
+  virtual void compile( expression::program_t& program );
+
   virtual double evaluate() = 0;
 
   virtual bool is_constant()
@@ -163,6 +272,11 @@ public:
     return false;
   }
 
+  virtual bool is_compiled()
+  {
+    return false;
+  }
+
   expression::token_e op_;
 
 private:
@@ -200,6 +314,11 @@ public:
   {
     return true;
   }
+
+  void compile( expression::program_t& program ) override
+  {
+    program.constant( value );
+  }
 };
 
 // Reference Expression - ref_expr_t
@@ -219,6 +338,14 @@ private:
   {
     return coerce( t );
   }
+
+  void compile( expression::program_t& program ) override
+  {
+    if constexpr ( std::is_same<T, double>::value || std::is_same<T, int>::value )
+      program.load( &t );
+    else
+      program.call( this );
+  }
 };
 
 // Template to return a reference expression
@@ -432,6 +432,8 @@ protected:
       fmt::format_to( out, "{}{}={}", name(), entry.first, entry.second );
     }
   }
+  bool is_prefix() const override
+  { return true; }
   opts::map_t& _ref;
 };
 
@@ -490,6 +492,9 @@ protected:
     }
   }
 
+  bool is_prefix() const override
+  { return true; }
+
   opts::map_list_t& _ref;
 };
 
@@ -611,6 +616,81 @@ opts::parse_status opts::parse( sim_t*                                      sim,
   return ret;
 }
 
+// opts::index_t ============================================================
+
+void opts::index_t::build( util::span<const std::unique_ptr<option_t>> options )
+{
+  _table = options.data();
+  _size  = options.size();
+  _exact.clear();
+  _prefix.clear();
+
+  // First option of a given name takes precedence, as in the linear scan
+  for ( size_t i = 0; i < options.size(); ++i )
+    ( options[ i ]->is_prefix() ? _prefix : _exact ).emplace( options[ i ]->name(), i );
+}
+
+size_t opts::index_t::find( util::string_view name ) const
+{
+  size_t index = std::numeric_limits<size_t>::max();
+
+  auto it = _exact.find( name );
+  if ( it != _exact.end() )
+    index = it->second;
+
+  // Prefix options match the name up to and including its last dot, ignoring a trailing '+'
+  if ( !_prefix.empty() && !name.empty() )
+  {
+    auto last = name.size() - 1;
+    if ( name[ last ] == '+' && last > 0 )
+      --last;
+
+    auto dot = name.rfind( '.', last );
+    if ( dot != util::string_view::npos )
+    {
+      auto prefix_it = _prefix.find( name.substr( 0, dot + 1 ) );
+      if ( prefix_it != _prefix.end() )
+        index = std::min( index, prefix_it->second );
+    }
+  }
+
+  return index;
+}
+
+opts::parse_status opts::index_t::parse( sim_t*                                      sim,
+                                         util::span<const std::unique_ptr<option_t>> options,
+                                         util::string_view                           name,
+                                         util::string_view                           value,
+                                         const parse_status_fn_t&                    status_fn )
+{
+  if ( _table != options.data() || _size != options.size() )
+    build( options );
+
+  auto index = find( name );
+  if ( index == std::numeric_limits<size_t>::max() )
+  {
+    auto ret = parse_status::NOT_FOUND;
+    if ( status_fn )
+    {
+      ret = status_fn( parse_status::NOT_FOUND, name, value );
+    }
+    return ret;
+  }
+
+  auto ret = options[ index ]->parse( sim, name, value );
+  if ( ret == parse_status::CONTINUE )
+  {
+    // Not expected, resolve through the linear scan
+    return opts::parse( sim, options, name, value, status_fn );
+  }
+
+  if ( status_fn )
+  {
+    ret = status_fn( ret, name, value );
+  }
+  return ret;
+}
+
 // option_t::parse ==========================================================
 
 void opts::parse( sim_t* sim, util::string_view /* context */, util::span<const std::unique_ptr<option_t>> options,
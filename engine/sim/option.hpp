@@ -45,6 +45,9 @@ public:
   opts::parse_status parse( sim_t* sim, util::string_view name, util::string_view value ) const;
   util::string_view name() const
   { return _name; }
+  // Option parses names that start with name() ( map options ), instead of the exact name
+  virtual bool is_prefix() const
+  { return false; }
   
   friend void sc_format_to( const option_t&, fmt::format_context::iterator );
 protected:
@@ -65,6 +68,23 @@ using list_t            = std::vector<std::string>;
 
 parse_status parse( sim_t*, util::span<const std::unique_ptr<option_t>>, util::string_view name, util::string_view value, const parse_status_fn_t& fn = nullptr );
 void parse( sim_t*, util::string_view context, util::span<const std::unique_ptr<option_t>>, util::string_view options_str, const parse_status_fn_t& fn = nullptr );
+
+/* Name index over an option table, (re)built on first use and whenever the table changes. Resolves the
+ * option a name parses into with the same precedence as the linear scan: the first option in table
+ * order that either has the exact name, or is a prefix ( map ) option matching the name.
+ */
+struct index_t
+{
+  parse_status parse( sim_t*, util::span<const std::unique_ptr<option_t>>, util::string_view name, util::string_view value, const parse_status_fn_t& fn = nullptr );
+
+private:
+  const std::unique_ptr<option_t>* _table = nullptr;
+  size_t _size = 0;
+  std::unordered_map<util::string_view, size_t> _exact, _prefix;
+
+  void build( util::span<const std::unique_ptr<option_t>> );
+  size_t find( util::string_view name ) const;
+};
 }
 
 inline void sc_format_to( const std::unique_ptr<option_t>& option, fmt::format_context::iterator out )
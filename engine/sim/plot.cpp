@@ -15,7 +15,9 @@
 #include "util/io.hpp"
 #include "util/plot_data.hpp"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 // ==========================================================================
 // Plot
@@ -35,7 +37,12 @@ plot_t::plot_t( sim_t* s )
     remaining_plot_stats( 0 ),
     remaining_plot_points( 0 ),
     dps_plot_positive( false ),
-    dps_plot_negative( false )
+    dps_plot_negative( false ),
+    dps_plot_concurrent( false ),
+    mutex(),
+    concurrent_sims(),
+    num_concurrent_jobs( 0 ),
+    completed_concurrent_jobs( 0 )
 {
   create_options();
 }
@@ -87,6 +94,21 @@ double plot_t::progress( std::string& phase, std::string* detailed )
   if ( num_plot_stats <= 0 )
     return 1;
 
+  {
+    AUTO_LOCK( mutex );
+    if ( num_concurrent_jobs > 0 )
+    {
+      phase = "Plot - Concurrent";
+      double pct = completed_concurrent_jobs;
+      for ( auto s : concurrent_sims )
+      {
+        pct += s->progress().pct();
+      }
+      sim->detailed_progress( detailed, completed_concurrent_jobs, num_concurrent_jobs );
+      return pct / num_concurrent_jobs;
+    }
+  }
+
   if ( current_plot_stat <= 0 )
     return 0;
 
@@ -124,6 +146,12 @@ void plot_t::analyze_stats()
       remaining_plot_stats++;
   num_plot_stats = remaining_plot_stats;
 
+  if ( dps_plot_concurrent )
+  {
+    analyze_stats_concurrent();
+    return;
+  }
+
   for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
   {
     if ( sim->is_canceled() )
@@ -138,22 +166,7 @@ void plot_t::analyze_stats()
 
     int start;
     int end;
-
-    if ( dps_plot_positive )
-    {
-      start = 0;
-      end = dps_plot_points;
-    }
-    else if ( dps_plot_negative )
-    {
-      start = -dps_plot_points;
-      end = 0;
-    }
-    else
-    {
-      start = -dps_plot_points / 2;
-      end = -start;
-    }
+    plot_range( start, end );
 
     for ( int j = start; j <= end; j++ )
     {
@@ -219,6 +232,172 @@ void plot_t::analyze_stats()
   }
 }
 
+// plot_t::plot_range =======================================================
+
+void plot_t::plot_range( int& start, int& end ) const
+{
+  if ( dps_plot_positive )
+  {
+    start = 0;
+    end = dps_plot_points;
+  }
+  else if ( dps_plot_negative )
+  {
+    start = -dps_plot_points;
+    end = 0;
+  }
+  else
+  {
+    start = -dps_plot_points / 2;
+    end = -start;
+  }
+}
+
+// plot_t::analyze_stats_concurrent =========================================
+
+void plot_t::analyze_stats_concurrent()
+{
+  // Every (stat, point) pair is one job, run single-threaded, and iteration i of every job uses the
+  // seed crn_seed + i, so neighbouring points differ only by the stat change. The zero point is
+  // shared by all stats. A job's sim only lives while the job runs, its results are kept per player
+  // (in players_by_name order), so at most "threads" point sims exist at once.
+  struct job_t
+  {
+    stat_e stat;
+    int point;
+    std::vector<plot_data_t> data;
+    bool success;
+  };
+
+  int start;
+  int end;
+  plot_range( start, end );
+
+  std::vector<job_t> jobs;
+  jobs.push_back( { STAT_NONE, 0, {}, false } );
+  for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+  {
+    if ( !is_plot_stat( i ) )
+      continue;
+
+    for ( int j = start; j <= end; j++ )
+    {
+      if ( j != 0 )
+        jobs.push_back( { i, j, {}, false } );
+    }
+  }
+
+  {
+    AUTO_LOCK( mutex );
+    num_concurrent_jobs = as<int>( jobs.size() );
+    completed_concurrent_jobs = 0;
+  }
+
+  // Without a target error every point runs the same iterations, otherwise each point stops at
+  // dps_plot_target_error, with the iterations as the upper bound
+  int n_iterations = dps_plot_iterations > 0 ? dps_plot_iterations : sim->iterations;
+  std::atomic<size_t> next_job( 0 );
+  auto worker = [ this, &jobs, &next_job, n_iterations ]() {
+    size_t index;
+    while ( ( index = next_job++ ) < jobs.size() && !sim->is_canceled() )
+    {
+      auto& job = jobs[ index ];
+      auto s = std::make_unique<sim_t>( sim );
+      s->scaling->scale_stat = job.stat;
+      s->scaling->scale_value = job.point * dps_plot_step;
+      s->scaling->crn_seed = sim->seed;
+      s->threads = 1;
+      s->target_error = dps_plot_target_error > 0 ? dps_plot_target_error : 0;
+      s->report_progress = 0;
+      s->iterations = n_iterations;
+      s->work_queue->init( n_iterations );
+      if ( s->work_queue->is_chunked() )
+      {
+        s->work_queue->chunked( 1 );
+      }
+
+      {
+        AUTO_LOCK( mutex );
+        concurrent_sims.push_back( s.get() );
+      }
+
+      s->partition();
+      job.success = s->iterate();
+      s->merge();
+      if ( job.success )
+      {
+        s->analyze();
+        for ( player_t* p : sim->players_by_name )
+        {
+          player_t* delta_p = s->find_player( p->name() );
+          scaling_metric_data_t scaling_data = delta_p->scaling_for_metric( sim->scaling->scaling_metric );
+
+          plot_data_t data;
+          data.value = scaling_data.value;
+          data.error = scaling_data.stddev * s->confidence_estimator;
+          data.plot_step = job.point * dps_plot_step;
+          job.data.push_back( data );
+        }
+      }
+
+      AUTO_LOCK( mutex );
+      if ( job.success && dps_plot_debug )
+      {
+        sim->out_debug.raw().print( "Stat={} Point={}\n", util::stat_type_string( job.stat ), job.point );
+        report::print_text( s.get(), true );
+      }
+      concurrent_sims.erase( range::find( concurrent_sims, s.get() ) );
+      ++completed_concurrent_jobs;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  size_t n_threads = std::min( jobs.size(), static_cast<size_t>( std::max( 1, sim->threads ) ) );
+  for ( size_t i = 1; i < n_threads; ++i )
+  {
+    threads.emplace_back( worker );
+  }
+  worker();
+  range::for_each( threads, []( std::thread& t ) { t.join(); } );
+
+  {
+    AUTO_LOCK( mutex );
+    num_concurrent_jobs = completed_concurrent_jobs = 0;
+  }
+
+  if ( sim->is_canceled() )
+    return;
+
+  const auto& zero_job = jobs.front();
+  for ( stat_e i = STAT_NONE; i < STAT_MAX; i++ )
+  {
+    if ( !is_plot_stat( i ) )
+      continue;
+
+    for ( int j = start; j <= end; j++ )
+    {
+      auto it = range::find_if( jobs, [ i, j ]( const job_t& job ) { return job.stat == i && job.point == j; } );
+      const job_t& job = j == 0 ? zero_job : *it;
+      if ( !job.success )
+        continue;
+
+      for ( size_t k = 0; k < sim->players_by_name.size(); ++k )
+      {
+        player_t* p = sim->players_by_name[ k ];
+        if ( !p->scaling->scales_with[ i ] )
+          continue;
+
+        plot_data_t data = job.data[ k ];
+        data.plot_step = j * dps_plot_step;
+        p->dps_plot_data[ i ].push_back( data );
+      }
+    }
+  }
+
+  remaining_plot_stats = 0;
+  remaining_plot_points = 0;
+}
+
 void plot_t::write_output_file()
 {
   if ( sim->reforge_plot_output_file_str.empty() )
@@ -269,4 +448,5 @@ void plot_t::create_options()
   sim->add_option( opt_bool( "dps_plot_debug", dps_plot_debug ) );
   sim->add_option( opt_bool( "dps_plot_positive", dps_plot_positive ) );
   sim->add_option( opt_bool( "dps_plot_negative", dps_plot_negative ) );
+  sim->add_option( opt_bool( "dps_plot_concurrent", dps_plot_concurrent ) );
 }
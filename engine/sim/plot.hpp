@@ -8,8 +8,10 @@
 #include "config.hpp"
 
 #include "sc_enums.hpp"
+#include "util/concurrency.hpp"
 
 #include <string>
+#include <vector>
 
 struct sim_t;
 
@@ -26,6 +28,11 @@ public:
   stat_e current_plot_stat;
   int num_plot_stats, remaining_plot_stats, remaining_plot_points;
   bool dps_plot_positive, dps_plot_negative;
+  bool dps_plot_concurrent;
+  mutex_t mutex;
+  // Concurrent mode: currently running point sims, and job counts for progress
+  std::vector<sim_t*> concurrent_sims;
+  int num_concurrent_jobs, completed_concurrent_jobs;
 
   plot_t( sim_t* s );
   void analyze();
@@ -34,6 +41,8 @@ public:
 
 private:
   void analyze_stats();
+  void analyze_stats_concurrent();
+  void plot_range( int& start, int& end ) const;
   void write_output_file();
   void create_options();
 };
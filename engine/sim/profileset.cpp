@@ -5,6 +5,7 @@
 
 #include "profileset.hpp"
 #include "dbc/dbc.hpp"
+#include "scale_factor_control.hpp"
 #include "sim_control.hpp"
 #include "sim.hpp"
 #include "report/reports.hpp"
@@ -20,6 +21,14 @@
 #include <memory>
 #include <sstream>
 
+#if ! defined( SC_WINDOWS )
+#include <cerrno>
+#include <csignal>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 namespace
 {
 // Options that allow "appending" or "mapping" cannot really be overridden in the current
@@ -103,12 +112,16 @@ std::string format_time( double seconds, bool milliseconds = true )
   return s.str();
 }
 
-// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
-// worker_t)
-void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim )
+// Profileset specific simulator settings, must be applied before the sim is initialized
+void prepare_profileset_sim( sim_t* parent, sim_t* profile_sim, unsigned race_round = 0 )
 {
-  // Reset random seed for the profileset sims
+  // Reset random seed for the profileset sims. Later racing rounds of deterministic sims need
+  // their own seed, as their results are pooled with the earlier rounds.
   profile_sim -> seed = 0;
+  if ( parent -> deterministic && race_round > 1 )
+  {
+    profile_sim -> seed = 31459 + 1024 * ( race_round - 1 );
+  }
   profile_sim -> profileset_enabled = true;
   profile_sim -> report_details = 0;
   if ( parent -> profileset_work_threads > 0 )
@@ -118,7 +131,42 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
     // progress. For normal profileset simming we can rely on the normal progressbar updates
     profile_sim -> report_progress = false;
   }
-  else
+}
+
+// Warm sims are initialized by the init threads while the parent sim runs, so they are built
+// standalone like the validation sims, and only attached to the parent when they are simulated.
+// The child sims of a multi-threaded profileset sim are built and initialized here as well.
+sim_t* create_warm_sim( sim_t* parent, sim_control_t* control )
+{
+  auto profile_sim = std::make_unique<sim_t>();
+  profile_sim -> profileset_enabled = true;
+  profile_sim -> setup( control );
+
+  // Settings a child sim inherits from the parent
+  profile_sim -> scaling -> scale_stat = parent -> scaling -> scale_stat;
+  profile_sim -> scaling -> scale_value = parent -> scaling -> scale_value;
+  profile_sim -> report_progress = parent -> report_progress;
+  profile_sim -> enchant = parent -> enchant;
+
+  prepare_profileset_sim( parent, profile_sim.get() );
+  profile_sim -> init();
+  profile_sim -> init_children();
+
+  return profile_sim.release();
+}
+
+// Deallocating profile_sim is the responsibility of the caller (i.e., profileset driver or
+// worker_t). Returns true if the results of the profileset were collected.
+bool simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*& profile_sim )
+{
+  // Warm sims have been prepared and initialized during profileset validation
+  bool warm = profile_sim -> initialized;
+  if ( ! warm )
+  {
+    prepare_profileset_sim( parent, profile_sim, set.race_round() );
+  }
+
+  if ( parent -> profileset_work_threads <= 0 )
   {
     profile_sim -> progress_bar.set_base( "Profileset" );
     profile_sim -> progress_bar.set_phase( set.name() );
@@ -137,7 +185,7 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
 
   if ( !ret || profile_sim -> is_canceled() )
   {
-    return;
+    return false;
   }
 
   const auto player = profile_sim -> player_no_pet_list[ parent->profileset_report_player_index ];
@@ -146,7 +194,8 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
   range::for_each( parent -> profileset_metric, [ & ]( scale_metric_e metric ) {
     auto data = profileset::metric_data( player, metric );
 
-    set.result( metric )
+    profileset::profile_result_t result( metric );
+    result
       .min( data.min )
       .first_quartile( data.first_quartile )
       .median( data.median )
@@ -156,6 +205,16 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
       .stddev( data.std_dev )
       .mean_stddev( data.mean_std_dev )
       .iterations( progress.current_iterations );
+
+    // Racing rounds refine the estimate of the earlier rounds
+    if ( set.is_racing() && set.result( metric ).iterations() > 0 )
+    {
+      set.result( metric ).merge( result );
+    }
+    else
+    {
+      set.result( metric ) = result;
+    }
   } );
 
   if ( ! parent -> profileset_output_data.empty() )
@@ -168,13 +227,189 @@ void simulate_profileset( sim_t* parent, profileset::profile_set_t& set, sim_t*&
 
   // Save global statistics back to parent sim
   parent -> elapsed_cpu  += profile_sim -> elapsed_cpu;
-  parent -> init_time    += profile_sim -> init_time;
+  // Warm sim init is accounted for in the profileset validation time
+  if ( ! warm )
+  {
+    parent -> init_time  += profile_sim -> init_time;
+  }
   parent -> merge_time   += profile_sim -> merge_time;
   parent -> analyze_time += profile_sim -> analyze_time;
   parent -> event_mgr.total_events_processed += profile_sim -> event_mgr.total_events_processed;
 
-  set.cleanup_options();
+  // Racing profilesets may need to be simulated again
+  if ( ! set.is_racing() )
+  {
+    set.cleanup_options();
+  }
+
+  return true;
+}
+
+#if ! defined( SC_WINDOWS )
+// Shared memory of multi-process profileset simulation (profileset_processes). Worker processes
+// claim profileset indices from the shared queue, and write the results of each profileset into
+// the shared result table. A profileset is claimed by setting its worker, and is only done once
+// its state is DONE or FAILED; a PENDING profileset has not been simulated, even if claimed. The
+// table is allocated before the workers are forked, and is shared between the processes as an
+// anonymous shared mapping.
+class shared_results_t : private noncopyable
+{
+public:
+  enum state_e : int
+  {
+    PENDING = 0,
+    RUNNING,
+    DONE,
+    FAILED
+  };
+
+  struct header_t
+  {
+    std::atomic<size_t> next; // Lowest possibly unclaimed profileset index
+    std::atomic<size_t> done; // Finished (or failed) profilesets
+  };
+
+  struct set_t
+  {
+    std::atomic<int>   state;
+    std::atomic<pid_t> worker; // Claiming worker process, 0 if unclaimed
+    uint64_t         events;
+    double           elapsed_cpu;
+    double           elapsed_time;
+  };
+
+  struct metric_t
+  {
+    profileset::statistical_data_t data;
+    uint64_t                       iterations;
+  };
+
+  static_assert( std::atomic<size_t>::is_always_lock_free && std::atomic<int>::is_always_lock_free &&
+                 std::atomic<pid_t>::is_always_lock_free,
+                 "Shared memory atomics must be lock free" );
+
+private:
+  void*  m_base;
+  size_t m_size;
+  size_t m_sets;
+  size_t m_metrics;
+
+  static size_t align( size_t offset )
+  { return ( offset + alignof( std::max_align_t ) - 1 ) & ~( alignof( std::max_align_t ) - 1 ); }
+
+  size_t set_offset() const
+  { return align( sizeof( header_t ) ); }
+
+  size_t metric_offset() const
+  { return set_offset() + align( m_sets * sizeof( set_t ) ); }
+
+public:
+  shared_results_t( size_t sets, size_t metrics ) :
+    m_base( nullptr ), m_size( 0 ), m_sets( sets ), m_metrics( metrics )
+  {
+    m_size = metric_offset() + m_sets * m_metrics * sizeof( metric_t );
+
+    void* base = mmap( nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if ( base == MAP_FAILED )
+    {
+      return;
+    }
+
+    m_base = base;
+
+    new ( m_base ) header_t { { 0 }, { 0 } };
+    for ( size_t i = 0; i < m_sets; ++i )
+    {
+      new ( &set( i ) ) set_t { { PENDING }, { 0 }, 0, 0, 0 };
+    }
+  }
+
+  ~shared_results_t()
+  {
+    if ( m_base )
+    {
+      munmap( m_base, m_size );
+    }
+  }
+
+  explicit operator bool() const
+  { return m_base != nullptr; }
+
+  header_t& header()
+  { return *reinterpret_cast<header_t*>( m_base ); }
+
+  set_t& set( size_t idx )
+  { return reinterpret_cast<set_t*>( static_cast<char*>( m_base ) + set_offset() )[ idx ]; }
+
+  metric_t& metric( size_t idx, size_t metric_idx )
+  {
+    return reinterpret_cast<metric_t*>( static_cast<char*>( m_base ) + metric_offset() )
+      [ idx * m_metrics + metric_idx ];
+  }
+};
+
+// Worker process main loop, simulates profilesets until the shared queue is exhausted
+void process_worker( profileset::profilesets_t& profilesets, sim_t* parent, shared_results_t& shared )
+{
+  const auto& sets = profilesets.profilesets();
+
+  while ( true )
+  {
+    auto idx = shared.header().next.fetch_add( 1 );
+    if ( idx >= sets.size() )
+    {
+      break;
+    }
+
+    // Profilesets requeued after a worker crash may already have been claimed by another worker
+    auto& record = shared.set( idx );
+    pid_t unclaimed = 0;
+    if ( ! record.worker.compare_exchange_strong( unclaimed, getpid() ) )
+    {
+      continue;
+    }
+
+    auto& set    = *sets[ idx ];
+
+    record.state = shared_results_t::RUNNING;
+
+    sim_t* profile_sim = nullptr;
+    bool ok            = false;
+    try
+    {
+      profile_sim = profilesets.profileset_sim( parent, set );
+      // The parent process reports the progress of all workers
+      profile_sim -> report_progress = false;
+
+      ok = simulate_profileset( parent, set, profile_sim );
+    }
+    catch ( const std::exception& e )
+    {
+      fmt::print( stderr, "\n\nError in profileset worker process: " );
+      util::print_chained_exception( e, stderr );
+      fmt::print( stderr, "\n\n" );
+    }
+
+    if ( ok )
+    {
+      for ( size_t midx = 0; midx < parent -> profileset_metric.size(); ++midx )
+      {
+        const auto& result = set.result( parent -> profileset_metric[ midx ] );
+        shared.metric( idx, midx ) = { result.statistical_data(), result.iterations() };
+      }
+
+      record.events       = profile_sim -> event_mgr.total_events_processed;
+      record.elapsed_cpu  = chrono::to_fp_seconds( profile_sim -> elapsed_cpu );
+      record.elapsed_time = chrono::to_fp_seconds( profile_sim -> elapsed_time );
+    }
+
+    record.state = ok ? shared_results_t::DONE : shared_results_t::FAILED;
+    shared.header().done++;
+
+    delete profile_sim;
+  }
 }
+#endif
 
 // Figure out if the option defines new actor(s) with their own scope
 bool is_actor_scope( const option_tuple_t& opt )
@@ -297,7 +532,12 @@ profilesets_t::profilesets_t() : m_state( STARTED ), m_mode( SEQUENTIAL ),
     m_control_lock( m_mutex, std::defer_lock ),
     m_max_workers( 0 ), 
     m_work_lock( m_work_mutex, std::defer_lock ),
-    m_total_elapsed()
+    m_total_elapsed(),
+    m_warm_sims( 0 ),
+    m_warm_reused( 0 ),
+    m_validate_time(),
+    m_saved_init_time(),
+    m_eliminated( 0 )
 { 
 
 }
@@ -315,8 +555,65 @@ profilesets_t::~profilesets_t()
 }
 
 profile_set_t::profile_set_t( std::string name, sim_control_t* opts, bool has_output ) :
-  m_name( std::move(name) ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr )
+  m_name( std::move(name) ), m_options( opts ), m_has_output( has_output ), m_output_data( nullptr ),
+  m_warm_sim( nullptr ), m_warm_init_time(), m_race_round( 0 ), m_race_iterations( 0 ),
+  m_eliminated_round( 0 )
+{
+}
+
+// Racing overrides are appended as the last options of the profileset, overriding any
+// iterations or target_error set by the base profile
+void profile_set_t::race( unsigned round, int iterations )
+{
+  assert( m_options && iterations > 0 );
+
+  auto& opts = m_options -> options;
+  if ( m_race_iterations == 0 )
+  {
+    opts.add( "global", "iterations", util::to_string( iterations ) );
+    opts.add( "global", "target_error", "0" );
+  }
+  else
+  {
+    opts[ opts.size() - 2 ].value = util::to_string( iterations );
+  }
+
+  m_race_round      = round;
+  m_race_iterations = iterations;
+}
+
+void profile_set_t::finish_race()
+{
+  if ( m_race_iterations > 0 )
+  {
+    m_options -> options.erase( m_options -> options.end() - 2, m_options -> options.end() );
+  }
+
+  m_race_round      = 0;
+  m_race_iterations = 0;
+}
+
+void profile_set_t::eliminate( unsigned round )
 {
+  m_eliminated_round = round;
+  m_race_iterations  = 0;
+  cleanup_options();
+}
+
+void profile_set_t::warm_sim( sim_t* sim, chrono::wall_clock::duration init_time )
+{
+  assert( m_warm_sim == nullptr );
+
+  m_warm_sim       = sim;
+  m_warm_init_time = init_time;
+}
+
+sim_t* profile_set_t::take_warm_sim()
+{
+  auto sim   = m_warm_sim;
+  m_warm_sim = nullptr;
+
+  return sim;
 }
 
 sim_control_t* profile_set_t::options() const
@@ -332,9 +629,44 @@ void profile_set_t::cleanup_options()
 
 profile_set_t::~profile_set_t()
 {
+  delete m_warm_sim;
   delete m_options;
 }
 
+// Pooled mean and variance of two independent samples. Quartiles and the median cannot be pooled
+// from the summary data, the ones of the larger sample are kept as the estimate.
+profile_result_t& profile_result_t::merge( const profile_result_t& other )
+{
+  double n1 = as<double>( m_iterations ), n2 = as<double>( other.m_iterations );
+  double n  = n1 + n2;
+  if ( n2 == 0 )
+  {
+    return *this;
+  }
+
+  double mean  = ( n1 * m_mean + n2 * other.m_mean ) / n;
+  double delta = other.m_mean - m_mean;
+  double m2    = ( n1 - 1 ) * m_stddev * m_stddev + ( n2 - 1 ) * other.m_stddev * other.m_stddev +
+                 delta * delta * n1 * n2 / n;
+  double stddev = n > 1 ? std::sqrt( m2 / ( n - 1 ) ) : 0;
+
+  if ( n2 > n1 )
+  {
+    m_median      = other.m_median;
+    m_1stquartile = other.m_1stquartile;
+    m_3rdquartile = other.m_3rdquartile;
+  }
+
+  m_mean        = mean;
+  m_min         = std::min( m_min, other.m_min );
+  m_max         = std::max( m_max, other.m_max );
+  m_stddev      = stddev;
+  m_mean_stddev = stddev / std::sqrt( n );
+  m_iterations += other.m_iterations;
+
+  return *this;
+}
+
 const profile_result_t& profile_set_t::result( scale_metric_e metric ) const
 {
   static const profile_result_t __default {};
@@ -411,7 +743,7 @@ void worker_t::execute()
 {
   try
   {
-    m_sim = new sim_t( m_parent, 0, m_profileset -> options() );
+    m_sim = m_master -> profileset_sim( m_parent, *m_profileset );
 
     simulate_profileset( m_parent, *m_profileset, m_sim );
   }
@@ -497,13 +829,7 @@ void profilesets_t::generate_work( sim_t* parent, std::unique_ptr<profile_set_t>
 {
   if ( m_mode == SEQUENTIAL )
   {
-    auto original_opts = parent -> control;
-
-    parent -> control = ptr_set -> options();
-
-    sim_t* profile_sim = new sim_t( parent );
-
-    parent -> control = original_opts;
+    sim_t* profile_sim = profileset_sim( parent, *ptr_set );
 
     simulate_profileset( parent, *ptr_set, profile_sim );
 
@@ -583,29 +909,72 @@ bool profilesets_t::parse( sim_t* sim )
              util::str_compare_ci( name, "json2" );
     } );
 
-    // Test that profileset options are OK, up to the simulation initialization
+    // With warm sims, wait until the driver has consumed enough of them to keep one more. This
+    // bounds the memory held by initialized, not yet simulated profilesets.
+    bool warm = false;
+    if ( sim -> profileset_warm_sims > 0 )
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_warm.wait( lock, [ this, sim ] {
+        return sim -> canceled || m_warm_sims < as<size_t>( sim -> profileset_warm_sims );
+      } );
+
+      if ( sim -> canceled )
+      {
+        lock.unlock();
+        delete control;
+        continue;
+      }
+
+      ++m_warm_sims;
+      warm = true;
+    }
+
+    auto set = std::make_unique<profile_set_t>( profileset_name, control, has_output_opts );
+    if ( sim -> profileset_race_top > 0 )
+    {
+      set -> race( 1, std::max( 1, sim -> profileset_race_iterations ) );
+    }
+
+    // Test that profileset options are OK, up to the simulation initialization. A warm sim is
+    // constructed and initialized exactly as the driver would, and kept for the actual simulation.
+    sim_t* warm_sim = nullptr;
+    const auto start_time = chrono::wall_clock::now();
     try
     {
-      std::unique_ptr<sim_t> test_sim = std::make_unique<sim_t>();
-      test_sim -> profileset_enabled = true;
+      if ( warm )
+      {
+        warm_sim = create_warm_sim( sim, control );
+      }
+      else
+      {
+        std::unique_ptr<sim_t> test_sim = std::make_unique<sim_t>();
+        test_sim -> profileset_enabled = true;
 
-      test_sim -> setup( control );
-      test_sim -> init();
+        test_sim -> setup( control );
+        test_sim -> init();
+      }
     }
     catch ( const std::exception& e )
     {
       fmt::print( stderr, "ERROR! Profileset '{}' Setup failure: ", profileset_name );
       util::print_chained_exception( e, stderr );
       fmt::print( stderr, "\n" );
+      delete warm_sim;
       set_state( DONE );
       m_control.notify_one();
-      delete control;
       return false;
     }
+    const auto validate_time = chrono::elapsed( start_time );
+
+    if ( warm_sim )
+    {
+      set -> warm_sim( warm_sim, validate_time );
+    }
 
     m_mutex.lock();
-    m_profilesets.push_back( std::make_unique<profile_set_t>(
-        profileset_name, control, has_output_opts ) );
+    m_validate_time += validate_time;
+    m_profilesets.push_back( std::move( set ) );
     m_control.notify_one();
     m_mutex.unlock();
   }
@@ -641,9 +1010,29 @@ void profilesets_t::initialize( sim_t* sim )
     return;
   }
 
+  if ( sim -> profileset_processes > 0 )
+  {
+#if defined( SC_WINDOWS )
+    sim -> errorf( "Option profileset_processes is not supported on this platform, ignoring" );
+    sim -> profileset_processes = 0;
+#else
+    if ( sim -> profileset_race_top > 0 || ! sim -> profileset_output_data.empty() )
+    {
+      sim -> errorf( "Option profileset_processes cannot be used with profileset_race_top or profileset_output_data, ignoring" );
+      sim -> profileset_processes = 0;
+    }
+    // Warm sims would be held by the parent process until all profilesets are initialized
+    sim -> profileset_warm_sims = 0;
+#endif
+  }
+
   // Figure out how many workers can we have by looking at how many threads we have, and how many
   // worker threads the user wants
-  if ( sim -> profileset_work_threads > 0 )
+  if ( sim -> profileset_processes > 0 )
+  {
+    m_max_workers = as<size_t>( sim -> profileset_processes );
+  }
+  else if ( sim -> profileset_work_threads > 0 )
   {
     size_t workers = as<size_t>( sim -> threads / sim -> profileset_work_threads );
     if ( workers == 0 )
@@ -655,8 +1044,9 @@ void profilesets_t::initialize( sim_t* sim )
     m_max_workers = workers;
   }
 
-  // Go parallel mode if we have any workers .. including one
-  if ( m_max_workers > 0 )
+  // Go parallel mode if we have any workers .. including one. Worker processes simulate their
+  // profilesets sequentially.
+  if ( m_max_workers > 0 && sim -> profileset_processes <= 0 )
   {
     m_mode = PARALLEL;
   }
@@ -690,6 +1080,9 @@ void profilesets_t::initialize( sim_t* sim )
 
 void profilesets_t::cancel()
 {
+  // Wake up any init threads waiting for a warm sim slot, they will notice the cancellation
+  m_warm.notify_all();
+
   if ( ! is_done() )
   {
     range::for_each( m_thread, []( std::thread& thread ) {
@@ -738,7 +1131,9 @@ bool profilesets_t::iterate( sim_t* parent )
 
   m_start_time = chrono::wall_clock::now();
 
-  while ( ! is_done() )
+  bool processes = simulate_processes( parent );
+
+  while ( ! processes && ! is_done() )
   {
     m_control_lock.lock();
 
@@ -769,6 +1164,11 @@ bool profilesets_t::iterate( sim_t* parent )
   // not need to finalize any work (all work has been done by the loop above)
   finalize_work();
 
+  if ( parent -> profileset_race_top > 0 )
+  {
+    race( parent );
+  }
+
   // Output profileset progressbar whenever we finish anything
   output_progressbar( parent );
 
@@ -782,11 +1182,320 @@ bool profilesets_t::iterate( sim_t* parent )
   return true;
 }
 
+// Simulate profilesets in profileset_processes forked worker processes. Returns false if profilesets
+// should be simulated in this process instead.
+bool profilesets_t::simulate_processes( sim_t* parent )
+{
+#if ! defined( SC_WINDOWS )
+  if ( parent -> profileset_processes <= 0 )
+  {
+    return false;
+  }
+
+  // Forking requires all profilesets to be initialized, and no other threads to run
+  range::for_each( m_thread, []( std::thread& thread ) {
+    if ( thread.joinable() )
+    {
+      thread.join();
+    }
+  } );
+
+  if ( parent -> canceled )
+  {
+    return true;
+  }
+
+  shared_results_t shared( m_profilesets.size(), parent -> profileset_metric.size() );
+  if ( ! shared )
+  {
+    parent -> errorf( "Unable to allocate shared memory for profileset processes, simulating in-process" );
+    parent -> profileset_processes = 0;
+    return false;
+  }
+
+  std::vector<pid_t> workers;
+  bool terminated = false;
+  auto spawn = [ & ]() {
+    // Ensure buffered output is not duplicated by the workers
+    std::fflush( stdout );
+    std::fflush( stderr );
+
+    pid_t pid = fork();
+    if ( pid == 0 )
+    {
+      process_worker( *this, parent, shared );
+      std::fflush( stdout );
+      std::fflush( stderr );
+      std::_Exit( 0 );
+    }
+    else if ( pid > 0 )
+    {
+      workers.push_back( pid );
+    }
+    else
+    {
+      perror( "Unable to fork profileset worker process" );
+    }
+  };
+
+  for ( int i = 0; i < parent -> profileset_processes; ++i )
+  {
+    spawn();
+  }
+
+  while ( ! workers.empty() )
+  {
+    if ( parent -> canceled && ! terminated )
+    {
+      range::for_each( workers, []( pid_t pid ) { kill( pid, SIGTERM ); } );
+      terminated = true;
+    }
+
+    int status = 0;
+    pid_t pid  = waitpid( -1, &status, WNOHANG );
+    if ( pid == 0 || ( pid < 0 && errno == EINTR ) )
+    {
+      m_work_index = shared.header().done;
+      output_progressbar( parent );
+      std::this_thread::sleep_for( std::chrono::milliseconds( 250 ) );
+      continue;
+    }
+    else if ( pid < 0 )
+    {
+      break;
+    }
+
+    workers.erase( std::remove( workers.begin(), workers.end(), pid ), workers.end() );
+
+    // A crashed worker only takes down the profileset it was simulating, the rest of the queue is
+    // continued by a replacement worker. A profileset the worker claimed, but did not start, is
+    // still pending and is requeued.
+    if ( ! WIFEXITED( status ) || WEXITSTATUS( status ) != 0 )
+    {
+      for ( size_t idx = 0; idx < m_profilesets.size(); ++idx )
+      {
+        auto& record = shared.set( idx );
+        if ( record.worker != pid )
+        {
+          continue;
+        }
+
+        if ( record.state == shared_results_t::RUNNING )
+        {
+          record.state = shared_results_t::FAILED;
+          shared.header().done++;
+        }
+        else if ( record.state == shared_results_t::PENDING )
+        {
+          record.worker = 0;
+          size_t next = shared.header().next;
+          while ( next > idx && ! shared.header().next.compare_exchange_weak( next, idx ) )
+          {
+          }
+        }
+      }
+
+      if ( ! parent -> canceled && shared.header().next < m_profilesets.size() )
+      {
+        spawn();
+      }
+    }
+  }
+
+  for ( size_t idx = 0; idx < m_profilesets.size(); ++idx )
+  {
+    auto& set    = *m_profilesets[ idx ];
+    auto& record = shared.set( idx );
+
+    if ( record.state != shared_results_t::DONE )
+    {
+      if ( ! parent -> canceled )
+      {
+        fmt::print( stderr, "ERROR! Profileset '{}' failed in a worker process\n", set.name() );
+      }
+      continue;
+    }
+
+    for ( size_t midx = 0; midx < parent -> profileset_metric.size(); ++midx )
+    {
+      const auto& metric = shared.metric( idx, midx );
+
+      set.result( parent -> profileset_metric[ midx ] )
+        .min( metric.data.min )
+        .first_quartile( metric.data.first_quartile )
+        .median( metric.data.median )
+        .mean( metric.data.mean )
+        .third_quartile( metric.data.third_quartile )
+        .max( metric.data.max )
+        .stddev( metric.data.std_dev )
+        .mean_stddev( metric.data.mean_std_dev )
+        .iterations( metric.iterations );
+    }
+
+    parent -> elapsed_cpu += std::chrono::duration_cast<chrono::cpu_clock::duration>(
+      std::chrono::duration<double>( record.elapsed_cpu ) );
+    parent -> event_mgr.total_events_processed += record.events;
+    m_total_elapsed += std::chrono::duration_cast<chrono::wall_clock::duration>(
+      std::chrono::duration<double>( record.elapsed_time ) );
+
+    set.cleanup_options();
+  }
+
+  m_work_index = m_profilesets.size();
+
+  return true;
+#else
+  (void) parent;
+  return false;
+#endif
+}
+
 void profilesets_t::notify_worker()
 {
   m_work.notify_one();
 }
 
+sim_t* profilesets_t::profileset_sim( sim_t* parent, profile_set_t& set )
+{
+  if ( sim_t* warm_sim = set.take_warm_sim() )
+  {
+    m_mutex.lock();
+    --m_warm_sims;
+    ++m_warm_reused;
+    // The validation init is the init the profileset sim would otherwise do again
+    m_saved_init_time += set.warm_init_time();
+    m_mutex.unlock();
+
+    m_warm.notify_one();
+
+    warm_sim -> parent = parent;
+    parent -> add_relative( warm_sim );
+
+    return warm_sim;
+  }
+
+  return new sim_t( parent, 0, set.options() );
+}
+
+// Successive halving of the profilesets. All profilesets have been simulated with the initial
+// racing budget, after which each round eliminates the profilesets that cannot reach the top
+// profilesets within the confidence interval of the primary metric. The survivors are simulated
+// with a doubled budget, and finally with the full simulation settings.
+void profilesets_t::race( sim_t* parent )
+{
+  auto iterations = std::max( 1, parent -> profileset_race_iterations );
+  unsigned round = 1;
+
+  auto survivors = eliminate( parent, round );
+  while ( ! parent -> canceled && survivors > as<size_t>( parent -> profileset_race_top ) &&
+          as<int>( round ) < parent -> profileset_race_rounds )
+  {
+    ++round;
+    iterations *= 2;
+
+    range::for_each( m_profilesets, [ round, iterations ]( profileset_entry_t& set ) {
+      if ( set -> eliminated_round() == 0 )
+      {
+        set -> race( round, iterations );
+      }
+    } );
+
+    simulate_round( parent );
+    survivors = eliminate( parent, round );
+  }
+
+  range::for_each( m_profilesets, []( profileset_entry_t& set ) {
+    if ( set -> eliminated_round() == 0 )
+    {
+      set -> finish_race();
+    }
+  } );
+
+  simulate_round( parent );
+}
+
+void profilesets_t::simulate_round( sim_t* parent )
+{
+  for ( auto& set : m_profilesets )
+  {
+    if ( parent -> canceled )
+    {
+      break;
+    }
+
+    if ( set -> eliminated_round() == 0 )
+    {
+      generate_work( parent, set );
+    }
+  }
+
+  finalize_work();
+}
+
+// Eliminate profilesets whose confidence interval is fully below the confidence interval of the
+// profileset_race_top'th best profileset, returns the number of surviving profilesets
+size_t profilesets_t::eliminate( const sim_t* parent, unsigned round )
+{
+  std::vector<profile_set_t*> sets;
+  range::for_each( m_profilesets, [ &sets ]( profileset_entry_t& set ) {
+    if ( set -> eliminated_round() == 0 )
+    {
+      sets.push_back( set.get() );
+    }
+  } );
+
+  auto top = as<size_t>( parent -> profileset_race_top );
+  if ( sets.size() <= top )
+  {
+    return sets.size();
+  }
+
+  range::sort( sets, []( const profile_set_t* l, const profile_set_t* r ) {
+    return l -> result().mean() > r -> result().mean();
+  } );
+
+  auto z = parent -> confidence_estimator;
+  const auto& cutoff = sets[ top - 1 ] -> result();
+  double lower_bound = cutoff.mean() - z * cutoff.mean_stddev();
+
+  size_t survivors = top;
+  for ( size_t i = top; i < sets.size(); ++i )
+  {
+    const auto& result = sets[ i ] -> result();
+    if ( result.mean() + z * result.mean_stddev() < lower_bound )
+    {
+      sets[ i ] -> eliminate( round );
+      ++m_eliminated;
+    }
+    else
+    {
+      ++survivors;
+    }
+  }
+
+  return survivors;
+}
+
+size_t profilesets_t::eliminated() const
+{
+  return m_eliminated;
+}
+
+size_t profilesets_t::warm_reused() const
+{
+  return m_warm_reused;
+}
+
+chrono::wall_clock::duration profilesets_t::validate_time() const
+{
+  return m_validate_time;
+}
+
+chrono::wall_clock::duration profilesets_t::saved_init_time() const
+{
+  return m_saved_init_time;
+}
+
 int profilesets_t::max_name_length() const
 {
   size_t len = 0;
@@ -955,6 +1664,11 @@ void create_options( sim_t* sim )
 
   sim -> add_option( opt_int( "profileset_work_threads", sim -> profileset_work_threads ) );
   sim -> add_option( opt_int( "profileset_init_threads", sim -> profileset_init_threads ) );
+  sim -> add_option( opt_int( "profileset_warm_sims", sim -> profileset_warm_sims ) );
+  sim -> add_option( opt_int( "profileset_processes", sim -> profileset_processes ) );
+  sim -> add_option( opt_int( "profileset_race_top", sim -> profileset_race_top ) );
+  sim -> add_option( opt_int( "profileset_race_iterations", sim -> profileset_race_iterations ) );
+  sim -> add_option( opt_int( "profileset_race_rounds", sim -> profileset_race_rounds ) );
 }
 
 statistical_data_t collect( const extended_sample_data_t& c )
@@ -1128,6 +1842,10 @@ bool profilesets_t::iterate( sim_t*  ) { return true ;}
 void profilesets_t::output_html( const sim_t&, std::ostream& ) const {}
 void profilesets_t::output_text( const sim_t&, std::ostream& ) const {}
 size_t profilesets_t::n_profilesets() const { return 0; }
+size_t profilesets_t::warm_reused() const { return 0; }
+chrono::wall_clock::duration profilesets_t::validate_time() const { return {}; }
+chrono::wall_clock::duration profilesets_t::saved_init_time() const { return {}; }
+size_t profilesets_t::eliminated() const { return 0; }
 bool profilesets_t::is_running() const { return false; }
 }
 
@@ -129,6 +129,9 @@ public:
 
   statistical_data_t statistical_data() const
   { return { m_min, m_1stquartile, m_median, m_mean, m_3rdquartile, m_max, m_stddev, m_mean_stddev }; }
+
+  // Pool the results of an independent run of the same profileset into this one
+  profile_result_t& merge( const profile_result_t& other );
 };
 
 class profile_output_data_item_t
@@ -384,6 +387,15 @@ class profile_set_t
   std::vector<profile_result_t>          m_results;
   std::unique_ptr<profile_output_data_t> m_output_data;
 
+  // Initialized simulator kept from option validation (profileset_warm_sims)
+  sim_t*                                 m_warm_sim;
+  chrono::wall_clock::duration           m_warm_init_time;
+
+  // Racing (profileset_race_top) state
+  unsigned                               m_race_round;
+  int                                    m_race_iterations;
+  unsigned                               m_eliminated_round;
+
 public:
   profile_set_t( std::string name, sim_control_t* opts, bool has_output );
 
@@ -406,6 +418,32 @@ public:
   size_t results() const
   { return m_results.size(); }
 
+  void warm_sim( sim_t* sim, chrono::wall_clock::duration init_time );
+
+  // Caller takes ownership of the returned sim, nullptr if no warm sim is held
+  sim_t* take_warm_sim();
+
+  chrono::wall_clock::duration warm_init_time() const
+  { return m_warm_init_time; }
+
+  // Simulate the profileset with a reduced iteration budget in the given racing round
+  void race( unsigned round, int iterations );
+
+  // Remove racing overrides, the next simulation of the profileset is a full run
+  void finish_race();
+
+  void eliminate( unsigned round );
+
+  unsigned race_round() const
+  { return m_race_round; }
+
+  bool is_racing() const
+  { return m_race_iterations > 0; }
+
+  // Racing round the profileset was eliminated in, 0 if it was not eliminated
+  unsigned eliminated_round() const
+  { return m_eliminated_round; }
+
   profile_output_data_t& output_data()
   {
     if ( ! m_output_data )
@@ -489,6 +527,16 @@ private:
   // Parallel profileset stats collection
   chrono::wall_clock::time_point         m_start_time;
   chrono::wall_clock::duration           m_total_elapsed;
+
+  // Warm profileset sims, number currently held is protected by m_mutex
+  size_t                                 m_warm_sims;
+  std::condition_variable                m_warm;
+  size_t                                 m_warm_reused;
+  chrono::wall_clock::duration           m_validate_time;
+  chrono::wall_clock::duration           m_saved_init_time;
+
+  // Profilesets eliminated during racing
+  size_t                                 m_eliminated;
 #endif
 
   int max_name_length() const;
@@ -502,7 +550,13 @@ private:
   void cleanup_work();
   void finalize_work();
 
-  sim_control_t* create_sim_options( const sim_control_t*, const std::vector<std::string>& opts, unsigned main_actor_index );
+  sim_control_t* create_sim_options( const sim_control_t*, const std::vector<std::string>& opts,
+                                    unsigned main_actor_index );
+
+  bool simulate_processes( sim_t* );
+  void race( sim_t* );
+  size_t eliminate( const sim_t*, unsigned round );
+  void simulate_round( sim_t* );
 public:
   profilesets_t();
 
@@ -517,6 +571,14 @@ public:
   // Worker sim finished
   void notify_worker();
 
+  // Returns the initialized sim of the profileset if one was kept warm, or constructs a new one
+  sim_t* profileset_sim( sim_t* parent, profile_set_t& set );
+
+  size_t warm_reused() const;
+  chrono::wall_clock::duration validate_time() const;
+  chrono::wall_clock::duration saved_init_time() const;
+  size_t eliminated() const;
+
   std::string current_profileset_name();
 
   bool parse( sim_t* );
@@ -265,12 +265,8 @@ struct adds_event_t final : public raid_event_t
 
   void regenerate_cache()
   {
-    for ( auto p : affected_players )
-    {
-      // Invalidate target caches
-      for ( size_t i = 0, end = p->action_list.size(); i < end; i++ )
-        p->action_list[ i ]->target_cache.is_valid = false;  // Regenerate Cache.
-    }
+    // Invalidate target caches
+    sim->target_cache_epoch++;
   }
 
   void _start() override
@@ -617,11 +613,8 @@ struct pull_event_t final : raid_event_t
 
   void regenerate_cache()
   {
-    for ( auto p : affected_players )
-    {
-      for ( size_t i = 0, end = p->action_list.size(); i < end; i++ )
-        p->action_list[ i ]->target_cache.is_valid = false;
-    }
+    // Invalidate target caches
+    sim->target_cache_epoch++;
   }
 
   void _start() override
@@ -795,12 +788,8 @@ struct move_enemy_t final : public raid_event_t
 
   void regenerate_cache()
   {
-    for ( auto p : affected_players )
-    {
-      // Invalidate target caches
-      for ( size_t i = 0, end = p->action_list.size(); i < end; i++ )
-        p->action_list[ i ]->target_cache.is_valid = false;  // Regenerate Cache.
-    }
+    // Invalidate target caches
+    sim->target_cache_epoch++;
   }
 
   void reset() override
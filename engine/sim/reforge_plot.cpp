@@ -14,8 +14,172 @@
 #include "util/io.hpp"
 #include "util/plot_data.hpp"
 
+#include <cmath>
+#include <limits>
 #include <sstream>
 
+namespace
+{
+// Quadratic response surface fit to the simulated reforge combos. Stat mods always sum to zero, so
+// only the first n-1 mods are independent and used as coordinates.
+struct response_surface_t
+{
+  size_t dims;
+  double scale;
+  std::vector<double> coefficients;
+  std::vector<double> covariance;  // (X^T X)^-1, row major
+  double noise_variance;
+
+  response_surface_t( size_t n_stats, double s )
+    : dims( n_stats > 0 ? n_stats - 1 : 0 ), scale( s > 0 ? s : 1.0 ), noise_variance( 0 )
+  {
+  }
+
+  size_t n_features() const
+  {
+    return 1 + dims + dims * ( dims + 1 ) / 2;
+  }
+
+  std::vector<double> features( const std::vector<plot_data_t>& row ) const
+  {
+    std::vector<double> f;
+    f.reserve( n_features() );
+    f.push_back( 1.0 );
+    for ( size_t i = 0; i < dims; i++ )
+      f.push_back( row[ i ].value / scale );
+    for ( size_t i = 0; i < dims; i++ )
+      for ( size_t j = i; j < dims; j++ )
+        f.push_back( row[ i ].value / scale * row[ j ].value / scale );
+    return f;
+  }
+
+  // Least squares fit over the rows (stat mods followed by the metric); the noise variance is the
+  // larger of the residual variance and the mean squared standard error of the sims.
+  bool fit( const std::vector<std::vector<plot_data_t>>& rows, double confidence_estimator )
+  {
+    size_t p = n_features();
+    if ( rows.size() < p )
+      return false;
+
+    std::vector<double> a( p * p, 0.0 ), b( p, 0.0 );
+    double sim_variance = 0;
+    for ( const auto& row : rows )
+    {
+      auto f = features( row );
+      double y = row[ dims + 1 ].value;
+      for ( size_t i = 0; i < p; i++ )
+      {
+        b[ i ] += f[ i ] * y;
+        for ( size_t j = 0; j < p; j++ )
+          a[ i * p + j ] += f[ i ] * f[ j ];
+      }
+      double se = confidence_estimator > 0 ? row[ dims + 1 ].error / confidence_estimator : 0;
+      sim_variance += se * se;
+    }
+    sim_variance /= rows.size();
+
+    // Gauss-Jordan inversion with partial pivoting
+    covariance.assign( p * p, 0.0 );
+    for ( size_t i = 0; i < p; i++ )
+      covariance[ i * p + i ] = 1.0;
+
+    for ( size_t col = 0; col < p; col++ )
+    {
+      size_t pivot = col;
+      for ( size_t r = col + 1; r < p; r++ )
+        if ( std::fabs( a[ r * p + col ] ) > std::fabs( a[ pivot * p + col ] ) )
+          pivot = r;
+
+      if ( std::fabs( a[ pivot * p + col ] ) < 1e-12 )
+        return false;
+
+      if ( pivot != col )
+      {
+        for ( size_t k = 0; k < p; k++ )
+        {
+          std::swap( a[ pivot * p + k ], a[ col * p + k ] );
+          std::swap( covariance[ pivot * p + k ], covariance[ col * p + k ] );
+        }
+      }
+
+      double inv = 1.0 / a[ col * p + col ];
+      for ( size_t k = 0; k < p; k++ )
+      {
+        a[ col * p + k ] *= inv;
+        covariance[ col * p + k ] *= inv;
+      }
+
+      for ( size_t r = 0; r < p; r++ )
+      {
+        if ( r == col || a[ r * p + col ] == 0 )
+          continue;
+        double factor = a[ r * p + col ];
+        for ( size_t k = 0; k < p; k++ )
+        {
+          a[ r * p + k ] -= factor * a[ col * p + k ];
+          covariance[ r * p + k ] -= factor * covariance[ col * p + k ];
+        }
+      }
+    }
+
+    coefficients.assign( p, 0.0 );
+    for ( size_t i = 0; i < p; i++ )
+      for ( size_t j = 0; j < p; j++ )
+        coefficients[ i ] += covariance[ i * p + j ] * b[ j ];
+
+    double ssr = 0;
+    for ( const auto& row : rows )
+    {
+      double r = row[ dims + 1 ].value - predict( row );
+      ssr += r * r;
+    }
+    double residual_variance = rows.size() > p ? ssr / ( rows.size() - p ) : 0;
+
+    noise_variance = std::max( residual_variance, sim_variance );
+    return true;
+  }
+
+  double predict( const std::vector<plot_data_t>& row ) const
+  {
+    auto f = features( row );
+    double v = 0;
+    for ( size_t i = 0; i < f.size(); i++ )
+      v += coefficients[ i ] * f[ i ];
+    return v;
+  }
+
+  double stddev( const std::vector<plot_data_t>& row ) const
+  {
+    auto f = features( row );
+    size_t p = f.size();
+    double v = 0;
+    for ( size_t i = 0; i < p; i++ )
+      for ( size_t j = 0; j < p; j++ )
+        v += f[ i ] * covariance[ i * p + j ] * f[ j ];
+    return std::sqrt( std::max( 0.0, v * noise_variance ) );
+  }
+};
+
+std::vector<plot_data_t> combo_row( const std::vector<int>& combo )
+{
+  std::vector<plot_data_t> row( combo.size() + 1 );
+  for ( size_t j = 0; j < combo.size(); j++ )
+  {
+    row[ j ].value = combo[ j ];
+    row[ j ].error = 0;
+  }
+  return row;
+}
+
+double combo_distance( const std::vector<int>& a, const std::vector<int>& b )
+{
+  double d = 0;
+  for ( size_t i = 0; i < a.size(); i++ )
+    d += static_cast<double>( a[ i ] - b[ i ] ) * ( a[ i ] - b[ i ] );
+  return d;
+}
+}  // namespace
+
 // ==========================================================================
 // Reforge Plot
 // ==========================================================================
@@ -31,7 +195,9 @@ reforge_plot_t::reforge_plot_t( sim_t* s )
     reforge_plot_target_error( 0 ),
     reforge_plot_debug( 0 ),
     current_stat_combo( -1 ),
-    num_stat_combos( 0 )
+    num_stat_combos( 0 ),
+    reforge_plot_adaptive( 0 ),
+    reforge_plot_exploration( 2.0 )
 {
   create_options();
 }
@@ -151,58 +317,190 @@ void reforge_plot_t::analyze_stats()
     }
   }
 
+  if ( reforge_plot_adaptive > 0 && reforge_plot_adaptive < num_stat_combos )
+  {
+    analyze_stats_adaptive( stat_mod_combos );
+    return;
+  }
+
   for ( size_t i = 0; i < stat_mod_combos.size(); i++ )
   {
     if ( sim->is_canceled() )
       break;
 
-    std::vector<plot_data_t> delta_result( stat_mod_combos[ i ].size() + 1 );
+    run_stat_combo( stat_mod_combos[ i ], as<int>( i ) );
+  }
+}
+
+// reforge_plot_t::run_stat_combo ===========================================
+
+bool reforge_plot_t::run_stat_combo( const std::vector<int>& combo, int index )
+{
+  std::vector<plot_data_t> delta_result = combo_row( combo );
+
+  current_reforge_sim = new sim_t( sim );
+  if ( reforge_plot_iterations > 0 )
+  {
+    current_reforge_sim->work_queue->init( reforge_plot_iterations );
+  }
+
+  std::stringstream s;
+  for ( size_t j = 0; j < combo.size(); j++ )
+  {
+    stat_e stat = reforge_plot_stat_indices[ j ];
+    int mod = combo[ j ];
+
+    current_reforge_sim->enchant.add_stat( stat, mod );
+
+    s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
+    if ( j < combo.size() - 1 )
+    {
+      s << ", ";
+    }
+  }
+
+  current_stat_combo = index;
+  current_reforge_sim->progress_bar.set_base( s.str() );
+  bool success = current_reforge_sim->execute();
+
+  for ( player_t* player : sim->players_by_name )
+  {
+    plot_data_t& data = delta_result[ combo.size() ];
+    player_t* delta_p = current_reforge_sim->find_player( player->name() );
+
+    scaling_metric_data_t scaling_data = delta_p->scaling_for_metric( player->sim->scaling->scaling_metric );
+
+    data.value = scaling_data.value;
+    data.error = scaling_data.stddev * current_reforge_sim->confidence_estimator;
+
+    player->reforge_plot_data.push_back( delta_result );
+  }
+
+  delete current_reforge_sim;
+  current_reforge_sim = nullptr;
+
+  return success;
+}
+
+// reforge_plot_t::analyze_stats_adaptive ===================================
+
+void reforge_plot_t::analyze_stats_adaptive( const std::vector<std::vector<int>>& stat_mod_combos )
+{
+  // Sim a space-filling subset of the grid first, then repeatedly fit a quadratic response surface
+  // per player and sim the combo with the highest upper confidence bound, i.e. where the surrogate
+  // is uncertain or predicts an optimum. Remaining combos are filled in from the final fit.
+  size_t n_stats = reforge_plot_stat_indices.size();
+  size_t budget = as<size_t>( reforge_plot_adaptive );
+  num_stat_combos = reforge_plot_adaptive;
+
+  response_surface_t probe( n_stats, reforge_plot_amount );
+  size_t n_initial = std::min( budget, std::max( probe.n_features() + 1, budget / 2 ) );
+
+  std::vector<bool> simulated( stat_mod_combos.size(), false );
+  std::vector<double> min_distance( stat_mod_combos.size() );
+  std::vector<int> origin( n_stats, 0 );
+  for ( size_t i = 0; i < stat_mod_combos.size(); i++ )
+  {
+    min_distance[ i ] = -combo_distance( stat_mod_combos[ i ], origin );
+  }
+
+  auto players = sim->players_by_name;
+  auto mark_simulated = [ & ]( size_t index ) {
+    simulated[ index ] = true;
+    for ( size_t i = 0; i < stat_mod_combos.size(); i++ )
+    {
+      double d = combo_distance( stat_mod_combos[ i ], stat_mod_combos[ index ] );
+      if ( min_distance[ i ] < 0 || d < min_distance[ i ] )
+        min_distance[ i ] = d;
+    }
+  };
+
+  // Farthest point sampling, starting from the combo closest to the current gear
+  auto next_space_filling = [ & ]() {
+    size_t best = stat_mod_combos.size();
+    for ( size_t i = 0; i < stat_mod_combos.size(); i++ )
+    {
+      if ( simulated[ i ] )
+        continue;
+      if ( best == stat_mod_combos.size() || min_distance[ i ] > min_distance[ best ] )
+        best = i;
+    }
+    return best;
+  };
 
-    current_reforge_sim = new sim_t( sim );
-    if ( reforge_plot_iterations > 0 )
+  auto next_acquisition = [ & ]() {
+    std::vector<response_surface_t> surfaces;
+    for ( const player_t* p : players )
     {
-      current_reforge_sim->work_queue->init( reforge_plot_iterations );
+      surfaces.emplace_back( n_stats, reforge_plot_amount );
+      if ( !surfaces.back().fit( p->reforge_plot_data, sim->confidence_estimator ) )
+        return next_space_filling();
     }
 
-    std::stringstream s;
-    for ( size_t j = 0; j < stat_mod_combos[ i ].size(); j++ )
+    size_t best = stat_mod_combos.size();
+    double best_score = std::numeric_limits<double>::lowest();
+    for ( size_t i = 0; i < stat_mod_combos.size(); i++ )
     {
-      stat_e stat = reforge_plot_stat_indices[ j ];
-      int mod = stat_mod_combos[ i ][ j ];
+      if ( simulated[ i ] )
+        continue;
+
+      auto row = combo_row( stat_mod_combos[ i ] );
+      double score = 0;
+      for ( size_t k = 0; k < players.size(); k++ )
+      {
+        double best_observed = std::numeric_limits<double>::lowest();
+        for ( const auto& observed : players[ k ]->reforge_plot_data )
+          best_observed = std::max( best_observed, observed.back().value );
 
-      current_reforge_sim->enchant.add_stat( stat, mod );
-      delta_result[ j ].value = mod;
-      delta_result[ j ].error = 0;
+        double ucb = surfaces[ k ].predict( row ) + reforge_plot_exploration * surfaces[ k ].stddev( row );
+        score += ( ucb - best_observed ) / std::max( 1.0, std::fabs( best_observed ) );
+      }
 
-      s << util::to_string( mod ) << " " << util::stat_type_abbrev( stat );
-      if ( j < stat_mod_combos[ i ].size() - 1 )
+      if ( score > best_score )
       {
-        s << ", ";
+        best_score = score;
+        best = i;
       }
     }
+    return best;
+  };
 
-    current_stat_combo = as<int>( i );
-    current_reforge_sim->progress_bar.set_base( s.str() );
-    current_reforge_sim->execute();
+  for ( size_t n = 0; n < budget && !sim->is_canceled(); n++ )
+  {
+    size_t index = n < n_initial ? next_space_filling() : next_acquisition();
+    if ( index >= stat_mod_combos.size() )
+      break;
 
-    for ( player_t* player : sim->players_by_name )
+    if ( reforge_plot_debug )
     {
-      if ( current_reforge_sim )
-      {
-        plot_data_t& data = delta_result[ stat_mod_combos[ i ].size() ];
-        player_t* delta_p = current_reforge_sim->find_player( player->name() );
+      sim->out_log.raw().print( "Reforge Plot {} sample {}:", n < n_initial ? "design" : "adaptive", n + 1 );
+      for ( size_t j = 0; j < n_stats; j++ )
+        sim->out_log.raw().print( " {}: {}", util::stat_type_string( reforge_plot_stat_indices[ j ] ),
+                                  stat_mod_combos[ index ][ j ] );
+      sim->out_log.raw() << "\n";
+    }
 
-        scaling_metric_data_t scaling_data = delta_p->scaling_for_metric( player->sim->scaling->scaling_metric );
+    mark_simulated( index );
+    if ( !run_stat_combo( stat_mod_combos[ index ], as<int>( n ) ) )
+      break;
+  }
 
-        data.value = scaling_data.value;
-        data.error = scaling_data.stddev * current_reforge_sim->confidence_estimator;
+  if ( sim->is_canceled() )
+    return;
 
-        player->reforge_plot_data.push_back( delta_result );
-      }
-    }
+  for ( player_t* p : players )
+  {
+    response_surface_t surface( n_stats, reforge_plot_amount );
+    if ( !surface.fit( p->reforge_plot_data, sim->confidence_estimator ) )
+      continue;
 
-    delete current_reforge_sim;
-    current_reforge_sim = nullptr;
+    for ( const auto& combo : stat_mod_combos )
+    {
+      auto row = combo_row( combo );
+      row.back().value = surface.predict( row );
+      row.back().error = surface.stddev( row ) * sim->confidence_estimator;
+      p->reforge_plot_surrogate.push_back( row );
+    }
   }
 }
 
@@ -243,6 +541,27 @@ void reforge_plot_t::write_output_file()
       out << plot_data_list.back().error << ", ";
       out << "\n";
     }
+
+    if ( !player->reforge_plot_surrogate.empty() )
+    {
+      out << player->name() << " Reforge Plot Surrogate:\n";
+
+      for ( stat_e stat_index : reforge_plot_stat_indices )
+      {
+        out << util::stat_type_string( stat_index ) << ", ";
+      }
+      out << " DPS-Predicted, DPS-Confidence\n";
+
+      for ( const auto& plot_data_list : player->reforge_plot_surrogate )
+      {
+        for ( const plot_data_t& plot_data : plot_data_list )
+        {
+          out << plot_data.value << ", ";
+        }
+        out << plot_data_list.back().error << ", ";
+        out << "\n";
+      }
+    }
   }
 }
 
@@ -311,4 +630,6 @@ void reforge_plot_t::create_options()
   sim->add_option( opt_int( "reforge_plot_amount", reforge_plot_amount ) );
   sim->add_option( opt_string( "reforge_plot_stat", reforge_plot_stat_str ) );
   sim->add_option( opt_bool( "reforge_plot_debug", reforge_plot_debug ) );
+  sim->add_option( opt_int( "reforge_plot_adaptive", reforge_plot_adaptive, 0, std::numeric_limits<int>::max() ) );
+  sim->add_option( opt_float( "reforge_plot_exploration", reforge_plot_exploration, 0, 100 ) );
 }
@@ -27,6 +27,8 @@ struct reforge_plot_t
   int reforge_plot_debug;
   int current_stat_combo;
   int num_stat_combos;
+  int reforge_plot_adaptive;
+  double reforge_plot_exploration;
 
   reforge_plot_t( sim_t* s );
 
@@ -38,6 +40,8 @@ struct reforge_plot_t
   double progress( std::string& phase, std::string* detailed = nullptr );
 
 private:
+  bool run_stat_combo( const std::vector<int>& combo, int index );
+  void analyze_stats_adaptive( const std::vector<std::vector<int>>& stat_mod_combos );
   void write_output_file();
   void create_options();
 };
\ No newline at end of file
@@ -13,7 +13,9 @@
 #include "report/reports.hpp"
 #include "util/util.hpp"
 
+#include <atomic>
 #include <memory>
+#include <thread>
 
 namespace { // UNNAMED NAMESPACE ==========================================
 
@@ -138,6 +140,9 @@ scale_factor_control_t::scale_factor_control_t( sim_t* s ) :
   num_scaling_stats( 0 ),
   remaining_scaling_stats( 0 ),
   scale_over(), scaling_metric( SCALE_METRIC_DPS ), scale_over_player(),
+  crn( 0 ),
+  crn_seed( 0 ),
+  crn_sims(),
   stats(new gear_stats_t())
 {
   create_options();
@@ -153,6 +158,17 @@ double scale_factor_control_t::progress( std::string& phase, std::string* detail
 
   if ( num_scaling_stats <= 0 ) return 0.0;
 
+  if ( ! crn_sims.empty() )
+  {
+    phase = "Scaling - CRN";
+    double pct = 0;
+    for ( auto s : crn_sims )
+    {
+      pct += s -> progress().pct();
+    }
+    return pct / crn_sims.size();
+  }
+
   if ( current_scaling_stat <= 0 )
   {
     phase = "Baseline";
@@ -241,6 +257,13 @@ void scale_factor_control_t::analyze_stats()
   baseline_sim = sim; // Take the current sim as baseline
   mutex.unlock();
 
+  if ( crn )
+  {
+    analyze_stats_crn( stats_to_scale );
+    baseline_sim = nullptr;
+    return;
+  }
+
   for ( const auto& stat : stats_to_scale )
   {
     if ( sim -> is_canceled() ) break;
@@ -276,80 +299,289 @@ void scale_factor_control_t::analyze_stats()
       ref_sim -> execute();
     }
 
-    for ( auto* p : sim->players_by_name )
+    analyze_stat( stat, scale_delta, center, ref_sim, delta_sim );
+
+    if ( debug_scale_factors )
     {
-       if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+      fmt::print( "\nref_sim report for '{}'...\n", util::stat_type_string( stat ) );
+      report::print_text( ref_sim, true );
+      fmt::print( "\ndelta_sim report for '{}'...\n", util::stat_type_string( stat ) );
+      report::print_text( delta_sim, true );
+    }
+
+    mutex.lock();
+    if ( ref_sim != baseline_sim && ref_sim != sim )
+    {
+      delete ref_sim;
+      ref_sim = nullptr;
+    }
+    delete delta_sim;  
+    delta_sim  = nullptr;
+    remaining_scaling_stats--;
+    mutex.unlock();
+  }
+
+  if ( baseline_sim != sim ) delete baseline_sim;
+  baseline_sim = nullptr;
+}
+
+// scaling_t::analyze_stats_crn =============================================
 
-      player_t*   ref_p =   ref_sim -> find_player( p -> name() );
-      player_t* delta_p = delta_sim -> find_player( p -> name() );
-      assert( ref_p && "Reference Player not found" );
-      assert( delta_p && "Delta player not found" );
+void scale_factor_control_t::analyze_stats_crn( const std::vector<stat_e>& stats_to_scale )
+{
+  // A reference sim with the same per-iteration seeds as the delta sims replaces the baseline, and
+  // centered stats get their own negative delta reference sim
+  struct job_t
+  {
+    stat_e stat;
+    double value;
+    sim_t* sim;
+    bool success;
+    crn_samples_t samples;
+  };
+
+  std::vector<job_t> jobs;
+  jobs.push_back( { STAT_MAX, 0, nullptr, false, {} } );
+  for ( const auto& stat : stats_to_scale )
+  {
+    double scale_delta = stats->get_stat( stat );
+    bool center        = center_scale_delta && ! stat_may_cap( stat );
 
-      double divisor = scale_delta;
+    jobs.push_back( { stat, +scale_delta / ( center ? 2 : 1 ), nullptr, false, {} } );
+    if ( center )
+    {
+      jobs.push_back( { stat, -scale_delta / 2, nullptr, false, {} } );
+    }
+  }
 
-      if ( delta_p -> invert_scaling )
-        divisor = -divisor;
+  // Every sim runs the same, fixed number of iterations in a single thread, so iteration i of
+  // every sim uses the seed crn_seed + i
+  int n_iterations = sim -> iterations;
+  for ( auto& job : jobs )
+  {
+    auto s = new sim_t( sim );
+    s -> scaling -> scale_stat  = job.stat;
+    s -> scaling -> scale_value = job.value;
+    s -> scaling -> crn_seed    = sim -> seed;
+    s -> threads         = 1;
+    s -> target_error    = 0;
+    s -> report_progress = 0;
+    s -> iterations      = n_iterations;
+    s -> work_queue -> init( n_iterations );
+    if ( s -> work_queue -> is_chunked() )
+    {
+      s -> work_queue -> chunked( 1 );
+    }
+    job.sim = s;
+  }
 
-      if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+  mutex.lock();
+  current_scaling_stat = stats_to_scale.front();
+  for ( const auto& job : jobs )
+  {
+    crn_sims.push_back( job.sim );
+  }
+  mutex.unlock();
 
-      for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+  std::atomic<size_t> next_job( 0 );
+  auto worker = [ this, &jobs, &next_job ]() {
+    size_t index;
+    while ( ( index = next_job++ ) < jobs.size() && ! sim -> is_canceled() )
+    {
+      auto& job = jobs[ index ];
+      job.sim -> partition();
+      job.success = job.sim -> iterate();
+      job.sim -> merge();
+
+      // Samples are in iteration order until analysis sorts them
+      if ( job.success )
       {
+        job.samples = collect_crn_samples( job.sim );
+        job.sim -> analyze();
+      }
 
-        double delta_score = delta_p -> scaling_for_metric( sm ).value;
-        double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+      if ( sim -> report_progress )
+      {
+        AUTO_LOCK( mutex );
+        fmt::print( "Scaling {} ({} of {}) done\n",
+            job.stat == STAT_MAX ? "Ref" : util::stat_type_abbrev( job.stat ), index + 1, jobs.size() );
+        std::fflush( stdout );
+      }
+    }
+  };
 
-        double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta_sim -> confidence_estimator;
-        double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref_sim -> confidence_estimator;
+  std::vector<std::thread> threads;
+  size_t n_threads = std::min( jobs.size(), static_cast<size_t>( std::max( 1, sim -> threads ) ) );
+  for ( size_t i = 1; i < n_threads; ++i )
+  {
+    threads.emplace_back( worker );
+  }
+  worker();
+  range::for_each( threads, []( std::thread& t ) { t.join(); } );
 
-        double score = ( delta_score - ref_score ) / divisor;
-        double error = delta_error * delta_error + ref_error * ref_error;
+  const auto& ref_job = jobs.front();
+  for ( size_t i = 1; i < jobs.size() && ! sim -> is_canceled(); ++i )
+  {
+    const auto& delta_job = jobs[ i ];
+    double scale_delta    = stats -> get_stat( delta_job.stat );
+    bool center           = center_scale_delta && ! stat_may_cap( delta_job.stat );
+    const auto& center_job = center ? jobs[ ++i ] : ref_job;
 
-        if ( error > 0 )
-          error = sqrt( error );
+    if ( ! delta_job.success || ! center_job.success )
+    {
+      continue;
+    }
 
-        error = fabs( error / divisor );
+    current_scaling_stat = delta_job.stat;
+    analyze_stat( delta_job.stat, scale_delta, center, center_job.sim, delta_job.sim,
+                  &center_job.samples, &delta_job.samples );
 
-        if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
-        {
-          score /= 10.0;
-          error /= 10.0;
-          delta_error /= 10.0;
-        }
+    if ( debug_scale_factors )
+    {
+      fmt::print( "\nref_sim report for '{}'...\n", util::stat_type_string( delta_job.stat ) );
+      report::print_text( center_job.sim, true );
+      fmt::print( "\ndelta_sim report for '{}'...\n", util::stat_type_string( delta_job.stat ) );
+      report::print_text( delta_job.sim, true );
+    }
+  }
 
-        analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+  mutex.lock();
+  crn_sims.clear();
+  remaining_scaling_stats = 0;
+  mutex.unlock();
 
-        if ( center )
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
-        else
-          p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+  for ( auto& job : jobs )
+  {
+    delete job.sim;
+  }
+}
+
+// scaling_t::collect_crn_samples ===========================================
+
+scale_factor_control_t::crn_samples_t scale_factor_control_t::collect_crn_samples( sim_t* s ) const
+{
+  crn_samples_t samples;
 
-        p -> scaling -> scaling[ sm ].set_stat( stat, score );
-        p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
+  for ( const auto* p : s -> players_by_name )
+  {
+    if ( ! p -> scale_player )
+      continue;
+
+    auto& player_samples = samples[ p -> name_str ];
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
+    {
+      auto data = p -> scaling_for_metric( sm ).samples;
+      if ( data && ! data -> simple && data -> data().size() == as<size_t>( s -> iterations ) )
+      {
+        player_samples[ sm ] = data -> data();
       }
     }
+  }
 
-    if ( debug_scale_factors )
+  return samples;
+}
+
+// scaling_t::analyze_stat ==================================================
+
+void scale_factor_control_t::analyze_stat( stat_e stat, double scale_delta, bool center, sim_t* ref, sim_t* delta,
+                                           const crn_samples_t* ref_samples, const crn_samples_t* delta_samples )
+{
+  for ( auto* p : sim->players_by_name )
+  {
+     if ( ! p -> scaling -> scales_with[ stat ] ) continue;
+
+    player_t*   ref_p =   ref -> find_player( p -> name() );
+    player_t* delta_p = delta -> find_player( p -> name() );
+    assert( ref_p && "Reference Player not found" );
+    assert( delta_p && "Delta player not found" );
+
+    double divisor = scale_delta;
+
+    if ( delta_p -> invert_scaling )
+      divisor = -divisor;
+
+    if ( divisor < 0.0 ) divisor += ref_p -> scaling -> over_cap[ stat ];
+
+    const std::array<std::vector<double>, SCALE_METRIC_MAX>* ref_data = nullptr;
+    const std::array<std::vector<double>, SCALE_METRIC_MAX>* delta_data = nullptr;
+    if ( ref_samples && delta_samples )
     {
-      fmt::print( "\nref_sim report for '{}'...\n", util::stat_type_string( stat ) );
-      report::print_text( ref_sim, true );
-      fmt::print( "\ndelta_sim report for '{}'...\n", util::stat_type_string( stat ) );
-      report::print_text( delta_sim, true );
+      auto ref_it   = ref_samples -> find( p -> name_str );
+      auto delta_it = delta_samples -> find( p -> name_str );
+      if ( ref_it != ref_samples -> end() && delta_it != delta_samples -> end() )
+      {
+        ref_data   = &ref_it -> second;
+        delta_data = &delta_it -> second;
+      }
     }
 
-    mutex.lock();
-    if ( ref_sim != baseline_sim && ref_sim != sim )
+    for ( scale_metric_e sm = SCALE_METRIC_NONE; sm < SCALE_METRIC_MAX; sm++ )
     {
-      delete ref_sim;
-      ref_sim = nullptr;
+
+      double delta_score = delta_p -> scaling_for_metric( sm ).value;
+      double   ref_score = ref_p -> scaling_for_metric( sm ).value;
+
+      double delta_error = delta_p -> scaling_for_metric( sm ).stddev * delta -> confidence_estimator;
+      double   ref_error = ref_p -> scaling_for_metric( sm ).stddev * ref -> confidence_estimator;
+
+      double score = ( delta_score - ref_score ) / divisor;
+      double error = delta_error * delta_error + ref_error * ref_error;
+
+      // Common random numbers, the error of the difference follows from the variance of the paired
+      // per-iteration differences, which is smaller than the sum of the variances when the
+      // iterations of both sims are correlated
+      bool paired = false;
+      if ( ref_data && delta_data && ! ( *ref_data )[ sm ].empty() &&
+           ( *ref_data )[ sm ].size() == ( *delta_data )[ sm ].size() )
+      {
+        const auto& r = ( *ref_data )[ sm ];
+        const auto& d = ( *delta_data )[ sm ];
+        size_t n      = r.size();
+
+        double mean_diff = 0;
+        for ( size_t i = 0; i < n; ++i )
+          mean_diff += d[ i ] - r[ i ];
+        mean_diff /= n;
+
+        double var_diff = 0;
+        for ( size_t i = 0; i < n; ++i )
+          var_diff += ( d[ i ] - r[ i ] - mean_diff ) * ( d[ i ] - r[ i ] - mean_diff );
+        var_diff /= n > 1 ? n - 1 : 1;
+
+        double paired_error = sqrt( var_diff / n ) * delta -> confidence_estimator;
+        if ( var_diff > 0 )
+        {
+          p -> scaling -> scaling_variance_reduction[ sm ].set_stat( stat,
+              error / ( paired_error * paired_error ) );
+        }
+
+        error  = paired_error * paired_error;
+        paired = true;
+      }
+
+      if ( error > 0 )
+        error = sqrt( error );
+
+      error = fabs( error / divisor );
+
+      if ( fabs( divisor ) < 1.0 ) // For things like Weapon Speed, show the gain per 0.1 speed gain rather than every 1.0.
+      {
+        score /= 10.0;
+        error /= 10.0;
+        delta_error /= 10.0;
+      }
+
+      analyze_ability_stats( stat, divisor, p, ref_p, delta_p );
+
+      if ( center || paired )
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, error );
+      else
+        p -> scaling -> scaling_compare_error[ sm ].set_stat( stat, delta_error / divisor );
+
+      p -> scaling -> scaling[ sm ].set_stat( stat, score );
+      p -> scaling -> scaling_error[ sm ].set_stat( stat, error );
     }
-    delete delta_sim;  
-    delta_sim  = nullptr;
-    remaining_scaling_stats--;
-    mutex.unlock();
   }
-
-  if ( baseline_sim != sim ) delete baseline_sim;
-  baseline_sim = nullptr;
 }
 
 /* Creates scale factors for stats_t objects
@@ -513,6 +745,7 @@ void scale_factor_control_t::create_options()
   sim->add_option(opt_bool("positive_scale_delta", positive_scale_delta));
   sim->add_option(opt_bool("scale_lag", scale_lag));
   sim->add_option(opt_float("scale_factor_noise", scale_factor_noise));
+  sim->add_option(opt_bool("scale_factor_crn", crn));
   sim->add_option(opt_float("scale_strength", stats->attribute[ATTR_STRENGTH]));
   sim->add_option(opt_float("scale_agility", stats->attribute[ATTR_AGILITY]));
   sim->add_option(opt_float("scale_stamina", stats->attribute[ATTR_STAMINA]));
@@ -8,8 +8,11 @@
 #include "config.hpp"
 #include "sc_enums.hpp"
 #include "util/concurrency.hpp"
+#include <array>
 #include <string>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
 struct gear_stats_t;
 struct player_t;
@@ -41,6 +44,13 @@ struct scale_factor_control_t
   scale_metric_e scaling_metric;
   std::string scale_over_player;
 
+  // Common random numbers: run all scaling sims concurrently with the same seed for the same
+  // iteration, and compute scale factor errors from paired per-iteration differences
+  int crn;
+  // Base seed of the per-iteration seeds of a common random numbers sim, 0 if not used
+  uint64_t crn_seed;
+  std::vector<sim_t*> crn_sims;
+
   // Gear delta for determining scale factors
   std::unique_ptr<gear_stats_t> stats;
 
@@ -49,10 +59,19 @@ struct scale_factor_control_t
   void init_deltas();
   void analyze();
   void analyze_stats();
+  void analyze_stats_crn( const std::vector<stat_e>& stats_to_scale );
   void analyze_ability_stats( stat_e, double, player_t*, player_t*, player_t* );
   void analyze_lag();
   void normalize();
   double progress( std::string& phase, std::string* detailed = nullptr );
   void create_options();
   bool has_scale_factors();
+
+private:
+  // Per player name, per scale metric iteration ordered samples
+  using crn_samples_t = std::unordered_map<std::string, std::array<std::vector<double>, SCALE_METRIC_MAX>>;
+
+  void analyze_stat( stat_e, double scale_delta, bool center, sim_t* ref, sim_t* delta,
+                     const crn_samples_t* ref_samples = nullptr, const crn_samples_t* delta_samples = nullptr );
+  crn_samples_t collect_crn_samples( sim_t* ) const;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 
 #include "sim.hpp"
 
+#include "action/action_state.hpp"
 #include "buff/buff.hpp"
 #include "class_modules/class_module.hpp"
 #include "dbc/dbc.hpp"
@@ -1366,11 +1367,7 @@ struct compare_name
 sim_progress_t work_queue_t::progress( int idx )
 {
   G l(m);
-  size_t current_index = idx;
-  if ( idx < 0 )
-  {
-    current_index = index;
-  }
+  size_t current_index = resolve( idx );
 
   if ( current_index >= _total_work.size() )
   {
@@ -1417,6 +1414,7 @@ sim_t::sim_t()
     heal_target( nullptr ),
     target_list(),
     target_non_sleeping_list(),
+    target_cache_epoch( 0 ),
     player_list(),
     player_no_pet_list(),
     player_non_sleeping_list(),
@@ -1445,6 +1443,21 @@ sim_t::sim_t()
     ignite_sampling_delta( 200_ms ),
     optimize_expressions( 2 ),
     optimize_expressions_rounds( 1 ),
+    compile_expressions( 0 ),
+    reset_dirty_tracking( 0 ),
+    apl_profile( 0 ),
+    apl_ready_cache( 0 ),
+    apl_versions(),
+    apl_ready_cache_lookups( 0 ),
+    apl_ready_cache_hits( 0 ),
+    apl_ready_cache_mismatches( 0 ),
+    expression_benchmark( 0 ),
+    expression_benchmark_evaluations( 0 ),
+    expression_benchmark_mismatches( 0 ),
+    expression_benchmark_tree_time( 0 ),
+    expression_benchmark_program_time( 0 ),
+    name_index_benchmark( false ),
+    name_index_benchmark_data(),
     current_slot( -1 ),
     optimal_raid( 0 ),
     log( 0 ),
@@ -1491,6 +1504,7 @@ sim_t::sim_t()
     seed( 0 ),
     deterministic( 0 ),
     strict_work_queue( 0 ),
+    chunked_work_queue( 0 ),
     average_range( true ),
     average_gauss( false ),
     fight_style(),
@@ -1505,6 +1519,7 @@ sim_t::sim_t()
     elapsed_cpu(),
     elapsed_time(),
     work_done( 0 ),
+    work_chunk(),
     iteration_dmg( 0 ),
     priority_iteration_dmg( 0 ),
     iteration_heal( 0 ),
@@ -1519,6 +1534,8 @@ sim_t::sim_t()
     merge_time(),
     init_time(),
     analyze_time(),
+    analyze_threads( 1 ),
+    analyze_workers( 1 ),
     report_iteration_data( 0.025 ),
     min_report_iteration_data( -1 ),
     report_progress( 1 ),
@@ -1536,6 +1553,10 @@ sim_t::sim_t()
     save_raid_summary( 0 ),
     save_gear_comments( 0 ),
     statistics_level( 1 ),
+    streaming_statistics( 0 ),
+    compact_statistics( 0 ),
+    use_action_state_arena( 0 ),
+    action_state_arena( nullptr ),
     separate_stats_by_actions( 0 ),
     report_raid_summary( 0 ),
     buff_uptime_timeline( 1 ),
@@ -1572,6 +1593,7 @@ sim_t::sim_t()
     display_hotfixes( false ),
     disable_hotfixes( false ),
     display_bonus_ids( false ),
+    client_data_output(),
     profileset_main_actor_index( 0 ),
     profileset_report_player_index( 0 ),
     profileset_multiactor_base_name( "Baseline" ),
@@ -1580,6 +1602,11 @@ sim_t::sim_t()
     profileset_enabled( false ),
     profileset_work_threads( 0 ),
     profileset_init_threads( 1 ),
+    profileset_warm_sims( 0 ),
+    profileset_race_top( 0 ),
+    profileset_race_iterations( 100 ),
+    profileset_race_rounds( 3 ),
+    profileset_processes( 0 ),
     profilesets( std::make_unique<profileset::profilesets_t>() )
 {
   item_db_sources.assign( std::begin( default_item_db_sources ), std::end( default_item_db_sources ) );
@@ -1651,9 +1678,20 @@ sim_t::sim_t( sim_t* p, int index, sim_control_t* control ) : sim_t()
 
 sim_t::~sim_t()
 {
+  // Children initialized ahead of a simulation that never ran, see init_children()
+  if ( requires_cleanup() )
+  {
+    range::dispose( children );
+  }
+
   assert( ( requires_cleanup() && relatives.empty() ) || ! requires_cleanup() );
   if( parent )
     parent -> remove_relative( this );
+
+  // Action states are destroyed with the actors, after this. The arena frees itself once the last
+  // one is gone.
+  if ( action_state_arena )
+    action_state_arena -> release();
 }
 
 // sim_t::iteration_time_adjust =============================================
@@ -1677,7 +1715,7 @@ double sim_t::iteration_time_adjust()
   }
   else
   {
-    auto progress = work_queue -> progress();
+    auto progress = work_queue -> progress( work_queue_index() );
     return 1.0 + vary_combat_length * ( ( current_iteration % 2 ) ? 1 : -1 ) * progress.pct();
   }
 }
@@ -1736,7 +1774,7 @@ void sim_t::cancel()
     errorf( "\nSimulation has been canceled during player setup! (thread=%d) %20s\n", thread_index, "" );
   }
 
-  work_queue -> flush();
+  work_queue -> flush( work_queue_index() );
 
   canceled = true;
 
@@ -1751,11 +1789,25 @@ void sim_t::cancel()
   }
 }
 
+// sim_t::work_queue_index ==================================================
+
+// Work queue index this sim is running. Chunked queue threads run their own claimed index, otherwise
+// the queue's shared index (-1) is used.
+int sim_t::work_queue_index() const
+{
+  return work_queue -> is_chunked() ? as<int>( work_chunk.index.load( std::memory_order_relaxed ) ) : -1;
+}
+
 // sim_t::interrupt =========================================================
 
 void sim_t::interrupt()
 {
-  work_queue -> flush();
+  // Children sharing the parent's queue run the index the parent flushes, their own chunk may be on
+  // another actor
+  if ( ! parent || parent -> work_queue != work_queue )
+  {
+    work_queue -> flush( work_queue_index() );
+  }
 
   for (auto & child : children)
   {
@@ -1804,6 +1856,14 @@ void sim_t::reset()
   if ( deterministic )
     seed = rng().reseed();
 
+  // Common random numbers scale factor sims use the same seed for the same iteration
+  if ( scaling -> crn_seed )
+  {
+    seed = scaling -> crn_seed + current_iteration;
+    rng().seed( seed );
+    rng().reset();
+  }
+
   event_mgr.reset();
 
   expected_iteration_time = max_time * iteration_time_adjust();
@@ -2132,11 +2192,11 @@ void sim_t::analyze_error()
 
   // First iterations of each thread are considered statistically insignificant and not
   // collected
-  int n_iterations = work_queue -> progress().current_iterations - threads;
+  int n_iterations = work_queue -> progress( work_queue_index() ).current_iterations - threads;
   if ( strict_work_queue )
   {
     range::for_each( children, [ &n_iterations ]( sim_t* c ) {
-      n_iterations += c -> work_queue -> progress().current_iterations;
+      n_iterations += c -> work_queue -> progress( c -> work_queue_index() ).current_iterations;
     } );
   }
 
@@ -2235,15 +2295,15 @@ void sim_t::analyze_error()
           ( target_error *  target_error ) ) );
       if ( ! strict_work_queue )
       {
-        work_queue -> project( projected_iterations );
+        work_queue -> project( projected_iterations, work_queue_index() );
       }
       else
       {
         // Divide work evenly between threads
         projected_iterations /= threads;
-        work_queue -> project( projected_iterations );
+        work_queue -> project( projected_iterations, work_queue_index() );
         range::for_each( children, [ projected_iterations ]( sim_t* c ) {
-          c -> work_queue -> project( projected_iterations );
+          c -> work_queue -> project( projected_iterations, c -> work_queue_index() );
         } );
       }
     }
@@ -2675,6 +2735,10 @@ void sim_t::init()
   if ( initialized )
     return;
 
+  if ( use_action_state_arena && ! action_state_arena )
+    action_state_arena = new action_state_arena_t();
+  action_state_arena_t::scope_t arena_scope( action_state_arena );
+
   event_mgr.init();
 
   unique_gear::register_target_data_initializers( this );
@@ -2983,9 +3047,33 @@ void sim_t::analyze()
   // Run core analyze for all actor collected data before proceeding to full analysis. This is to prevent errors from
   // when actors access information from each other, e.g. buffs.
   for ( size_t i = 0; i < actor_list.size(); i++ )
-  {
     actor_list[ i ] -> pre_analyze_hook();
-    actor_list[ i ] -> collected_data.analyze( *actor_list[ i ] );
+
+  // Collected data of an actor only depends on the actor itself and the shared divisor timelines, so
+  // it can be analyzed concurrently. Profileset and child sims already run alongside other sims, and
+  // always analyze serially.
+  int requested_workers = analyze_threads > 0 ? analyze_threads : threads;
+  if ( parent || profileset_enabled )
+    requested_workers = 1;
+  analyze_workers = std::max( 1, std::min( requested_workers, as<int>( actor_list.size() ) ) );
+  if ( analyze_workers > 1 )
+  {
+    std::atomic<size_t> next_actor( 0 );
+    auto worker = [ this, &next_actor ]() {
+      size_t index;
+      while ( ( index = next_actor++ ) < actor_list.size() )
+        actor_list[ index ] -> collected_data.analyze( *actor_list[ index ] );
+    };
+
+    std::vector<std::thread> workers;
+    for ( int i = 0; i < analyze_workers; ++i )
+      workers.emplace_back( worker );
+    range::for_each( workers, []( std::thread& t ) { t.join(); } );
+  }
+  else
+  {
+    for ( size_t i = 0; i < actor_list.size(); i++ )
+      actor_list[ i ] -> collected_data.analyze( *actor_list[ i ] );
   }
 
   for ( size_t i = 0; i < actor_list.size(); i++ )
@@ -3058,6 +3146,8 @@ bool sim_t::iterate()
 
   progress_bar.init();
 
+  action_state_arena_t::scope_t arena_scope( action_state_arena );
+
   activate_actors();
 
   bool more_work = true;
@@ -3077,8 +3167,8 @@ bool sim_t::iterate()
     auto old_active = current_index;
     if ( ! canceled )
     {
-      current_index = work_queue -> pop();
-      more_work = work_queue -> more_work();
+      current_index = work_queue -> pop( work_chunk );
+      more_work = work_queue -> more_work( work_chunk );
 
       if ( more_work && current_index != old_active )
       {
@@ -3170,6 +3260,8 @@ void sim_t::merge( sim_t& other_sim )
 
   iterations += other_sim.iterations;
   work_per_thread[ other_sim.thread_index ] = other_sim.work_done;
+  work_claims_per_thread[ other_sim.thread_index ] = other_sim.work_chunk.claims;
+  work_claimed_per_thread[ other_sim.thread_index ] = other_sim.work_chunk.claimed;
 
   simulation_length.merge( other_sim.simulation_length );
   total_dmg.merge( other_sim.total_dmg );
@@ -3179,6 +3271,17 @@ void sim_t::merge( sim_t& other_sim )
   total_absorb.merge( other_sim.total_absorb );
   raid_aps.merge( other_sim.raid_aps );
   event_mgr.merge( other_sim.event_mgr );
+  expression_benchmark_evaluations += other_sim.expression_benchmark_evaluations;
+  expression_benchmark_mismatches += other_sim.expression_benchmark_mismatches;
+  expression_benchmark_tree_time += other_sim.expression_benchmark_tree_time;
+  expression_benchmark_program_time += other_sim.expression_benchmark_program_time;
+  apl_ready_cache_lookups += other_sim.apl_ready_cache_lookups;
+  apl_ready_cache_hits += other_sim.apl_ready_cache_hits;
+  apl_ready_cache_mismatches += other_sim.apl_ready_cache_mismatches;
+  if ( action_state_arena && other_sim.action_state_arena )
+    action_state_arena -> merge( *other_sim.action_state_arena );
+  if ( name_index_benchmark_data && other_sim.name_index_benchmark_data )
+    name_index_benchmark_data -> merge( *other_sim.name_index_benchmark_data );
 
   for ( auto & buff : buff_list )
   {
@@ -3217,6 +3320,8 @@ void sim_t::merge( sim_t& other_sim )
 void sim_t::merge()
 {
   work_per_thread[ thread_index ] = work_done;
+  work_claims_per_thread[ thread_index ] = work_chunk.claims;
+  work_claimed_per_thread[ thread_index ] = work_chunk.claimed;
 
   if ( children.empty() )
     return;
@@ -3286,28 +3391,14 @@ void sim_t::partition()
     work_queue -> init( iterations );
   }
 
-  int num_children = threads - 1;
-
-  sim_control_t* child_control = nullptr;
-  // Filter out profileset-related options from the child sim control, since they are not going to
-  // use them anyhow. This significantly speeds up child creation in situations where the input
-  // profile is a very large set of profileset sims.
-  if ( !profileset_map.empty() )
-  {
-    child_control = profileset::filter_control( control );
-  }
-  else
+  // Children may have been created (and initialized) ahead of time, see init_children()
+  if ( children.empty() )
   {
-    child_control = control;
+    create_children();
   }
 
-  for ( int i = 0; i < num_children; i++ )
+  for ( auto child : children )
   {
-    auto  child = new sim_t( this, i + 1, child_control );
-
-    assert( child );
-    children.push_back( child );
-
     child -> iterations = iterations;
     if ( remainder )
     {
@@ -3330,6 +3421,34 @@ void sim_t::partition()
 
   for ( auto & child : children )
     child -> launch();
+}
+
+// sim_t::create_children ===================================================
+
+void sim_t::create_children()
+{
+  int num_children = threads - 1;
+
+  sim_control_t* child_control = nullptr;
+  // Filter out profileset-related options from the child sim control, since they are not going to
+  // use them anyhow. This significantly speeds up child creation in situations where the input
+  // profile is a very large set of profileset sims.
+  if ( !profileset_map.empty() )
+  {
+    child_control = profileset::filter_control( control );
+  }
+  else
+  {
+    child_control = control;
+  }
+
+  for ( int i = 0; i < num_children; i++ )
+  {
+    auto  child = new sim_t( this, i + 1, child_control );
+
+    assert( child );
+    children.push_back( child );
+  }
 
   // Safe to do for now, since control is only referenced by sim_t::setup, which is called in the
   // sim_t constructor.
@@ -3339,6 +3458,24 @@ void sim_t::partition()
   }
 }
 
+// sim_t::init_children =====================================================
+
+// Construct and initialize the child sims partition() would create, before the simulation runs.
+// Warm profileset sims do this in the profileset init threads, so simulating the profileset does
+// not build or initialize any sims.
+void sim_t::init_children()
+{
+  if ( ! children.empty() || threads <= 1 || work_queue -> size() < threads )
+    return;
+
+  create_children();
+
+  for ( auto child : children )
+  {
+    child -> init();
+  }
+}
+
 // sim_t::execute ===========================================================
 
 bool sim_t::execute()
@@ -3669,6 +3806,7 @@ void sim_t::create_options()
   add_option( opt_float( "vary_combat_length", vary_combat_length, 0.0, 1.0 ) );
   add_option( opt_func( "ptr", parse_ptr ) );
   add_option( opt_int( "threads", threads ) );
+  add_option( opt_int( "analyze_threads", analyze_threads, 0, std::numeric_limits<int>::max() ) );
   add_option( opt_float( "confidence", confidence, 0.0, 1.0 ) );
   add_option( opt_func( "spell_query", parse_spell_query ) );
   add_option( opt_string( "spell_query_xml_output_file", spell_query_xml_output_file_str ) );
@@ -3678,6 +3816,12 @@ void sim_t::create_options()
   add_option( opt_int( "max_aoe_enemies", max_aoe_enemies ) );
   add_option( opt_int( "optimize_expressions", optimize_expressions, 0, std::numeric_limits<int>::max() ) );
   add_option( opt_int( "optimize_expressions_rounds", optimize_expressions_rounds, 0, 100 ) );
+  add_option( opt_bool( "compile_expressions", compile_expressions ) );
+  add_option( opt_int( "reset_dirty_tracking", reset_dirty_tracking, 0, 2 ) );
+  add_option( opt_int( "apl_profile", apl_profile, 0, std::numeric_limits<int>::max() ) );
+  add_option( opt_int( "apl_ready_cache", apl_ready_cache, 0, 2 ) );
+  add_option( opt_int( "expression_benchmark", expression_benchmark, 0, 100000 ) );
+  add_option( opt_bool( "name_index_benchmark", name_index_benchmark ) );
   add_option( opt_bool( "single_actor_batch", single_actor_batch ) );
   add_option( opt_bool( "progressbar_type", progressbar_type ) );
   add_option( opt_bool( "allow_experimental_specializations", allow_experimental_specializations ) );
@@ -3753,6 +3897,7 @@ void sim_t::create_options()
   // RNG
   add_option( opt_bool( "deterministic", deterministic ) );
   add_option( opt_bool( "strict_work_queue", strict_work_queue ) );
+  add_option( opt_bool( "chunked_work_queue", chunked_work_queue ) );
   add_option( opt_float( "report_iteration_data", report_iteration_data ) );
   add_option( opt_int( "min_report_iteration_data", min_report_iteration_data ) );
   add_option( opt_bool( "average_range", average_range ) );
@@ -3764,6 +3909,8 @@ void sim_t::create_options()
   add_option( opt_float( "wheel_granularity", event_mgr.wheel_granularity ) );
   add_option( opt_int( "wheel_seconds", event_mgr.wheel_seconds ) );
   add_option( opt_int( "wheel_shift", event_mgr.wheel_shift ) );
+  add_option( opt_bool( "wheel_hierarchical", event_mgr.hierarchical ) );
+  add_option( opt_bool( "report_event_sizes", event_mgr.collect_size_histogram ) );
   add_option( opt_string( "reference_player", reference_player_str ) );
   add_option( opt_string( "raid_events", raid_events_str ) );
   add_option( opt_append( "raid_events+", raid_events_str ) );
@@ -3853,6 +4000,9 @@ void sim_t::create_options()
   add_option( opt_bool( "report_raw_abilities", report_raw_abilities ) );
   add_option( opt_bool( "report_rng", report_rng ) );
   add_option( opt_int( "statistics_level", statistics_level ) );
+  add_option( opt_bool( "streaming_statistics", streaming_statistics ) );
+  add_option( opt_bool( "compact_statistics", compact_statistics ) );
+  add_option( opt_bool( "action_state_arena", use_action_state_arena ) );
   add_option( opt_bool( "separate_stats_by_actions", separate_stats_by_actions ) );
   add_option( opt_bool( "report_raid_summary", report_raid_summary ) ); // Force reporting of raid summary
   add_option( opt_string( "reforge_plot_output_file", reforge_plot_output_file_str ) );
@@ -3877,6 +4027,8 @@ void sim_t::create_options()
   add_option( opt_bool( "show_hotfixes", display_hotfixes ) );
   // Bonus ids
   add_option( opt_bool( "show_bonus_ids", display_bonus_ids ) );
+  // External client data
+  add_option( opt_string( "write_client_data", client_data_output ) );
 
   // Expansion-specific options
 
@@ -4124,7 +4276,7 @@ bool sim_t::parse_option( const std::string& name,
 {
   if ( active_player )
   {
-    auto ret = opts::parse( this, active_player->options, name, value );
+    auto ret = active_player->option_index.parse( this, active_player->options, name, value );
 
     // Bail out early on player-specific option error states
     switch ( ret )
@@ -4139,7 +4291,7 @@ bool sim_t::parse_option( const std::string& name,
     }
   }
 
-  auto ret = opts::parse( this, options, name, value );
+  auto ret = option_index.parse( this, options, name, value );
   // With strict_parsing enabled, anything else than "ok" parse status will result in hard failure
   if ( strict_parsing && ret != opts::parse_status::OK )
   {
@@ -4177,6 +4329,14 @@ void sim_t::setup( sim_control_t* c )
     }
   }
 
+  if ( name_index_benchmark )
+  {
+    name_index_benchmark_data = std::make_unique<dbc::name_index_benchmark_t>();
+    dbc->name_index_benchmark = name_index_benchmark_data.get();
+    for ( auto& actor : actor_list )
+      actor->dbc->name_index_benchmark = name_index_benchmark_data.get();
+  }
+
   // Combat
   // Try very hard to limit this to just what would be displayed on the gui.
   // Super-users can use misc options.
@@ -4201,7 +4361,7 @@ void sim_t::setup( sim_control_t* c )
                     o.scope, o.name, o.value));
     }
 
-    auto ret = opts::parse( this, p->options, o.name, o.value );
+    auto ret = p->option_index.parse( this, p->options, o.name, o.value );
     if ( ret == opts::parse_status::FAILURE )
     {
       throw std::invalid_argument(fmt::format("Unable to parse option '{}' with value '{}' for player '{}'.",
@@ -4209,7 +4369,8 @@ void sim_t::setup( sim_control_t* c )
     }
   }
 
-  if ( player_list.empty() && spell_query == nullptr && !display_bonus_ids && display_build <= 1 )
+  if ( player_list.empty() && spell_query == nullptr && !display_bonus_ids && client_data_output.empty() &&
+       display_build <= 1 )
   {
     throw std::runtime_error( "Nothing to sim!" );
   }
@@ -4290,9 +4451,16 @@ void sim_t::setup( sim_control_t* c )
     work_queue -> batches( player_no_pet_list.size() );
   }
   work_queue -> init( iterations );
+  if ( chunked_work_queue )
+  {
+    // Deterministic and strict work queue sims give each thread its own queue
+    work_queue -> chunked( deterministic || strict_work_queue ? 1 : threads );
+  }
   if ( thread_index == 0 )
   {
     work_per_thread.resize( threads );
+    work_claims_per_thread.resize( threads );
+    work_claimed_per_thread.resize( threads );
   }
 
   if( deterministic && ( target_error != 0 ) )
@@ -4485,16 +4653,23 @@ std::vector<double> sc_timeline_t::build_divisor_timeline( const extended_sample
  */
 void sc_timeline_t::adjust( sim_t& sim )
 {
-  // Check if we have divisor timeline cached
-  auto it = sim.divisor_timeline_cache.find( bin_size_ );
-  if ( it == sim.divisor_timeline_cache.end() )
+  const std::vector<double>* divisor_timeline;
   {
-    // If we don't have a cached divisor timeline, build one
-    sim.divisor_timeline_cache[ bin_size_ ] = build_divisor_timeline( sim.simulation_length, bin_size_ );
+    // Actors are analyzed concurrently, map nodes stay valid once inserted
+    AUTO_LOCK( sim.divisor_timeline_mutex );
+
+    // Check if we have divisor timeline cached
+    auto it = sim.divisor_timeline_cache.find( bin_size_ );
+    if ( it == sim.divisor_timeline_cache.end() )
+    {
+      // If we don't have a cached divisor timeline, build one
+      it = sim.divisor_timeline_cache.emplace( bin_size_, build_divisor_timeline( sim.simulation_length, bin_size_ ) ).first;
+    }
+    divisor_timeline = &it->second;
   }
 
   // Do the timeline adjustement
-  timeline_t::adjust( sim.divisor_timeline_cache[ bin_size_ ] );
+  timeline_t::adjust( *divisor_timeline );
 }
 
 void sc_timeline_t::adjust( const extended_sample_data_t& adjustor )
@@ -4594,6 +4769,9 @@ void sim_t::activate_actors()
   healing_no_pet_list.reset_callbacks();
   healing_pet_list.reset_callbacks();
 
+  // Action target caches compare against the epoch instead of registering one callback per action
+  target_non_sleeping_list.register_callback( [ this ]( player_t* ) { target_cache_epoch++; } );
+
   // Normal sim mode activates all actors .. and this method is only called once at the beginning of
   // the simulation run.
   if ( ! single_actor_batch )
@@ -6,11 +6,13 @@
 #pragma once
 
 #include "config.hpp"
+#include "apl_versions.hpp"
 #include "event_manager.hpp"
 #include "player/gear_stats.hpp"
 #include "progress_bar.hpp"
 #include "sim_ostream.hpp"
 #include "sim/option.hpp"
+#include "sim/work_queue.hpp"
 #include "util/concurrency.hpp"
 #include "util/rng.hpp"
 #include "util/sample_data.hpp"
@@ -20,11 +22,15 @@
 #include <map>
 #include <memory>
 
+class action_state_arena_t;
 struct actor_target_data_t;
 struct buff_t;
 struct cooldown_t;
 class dbc_t;
 class dbc_override_t;
+namespace dbc {
+    struct name_index_benchmark_t;
+}
 struct expr_t;
 namespace highchart {
     struct chart_t;
@@ -38,7 +44,6 @@ struct scale_factor_control_t;
 struct sim_control_t;
 struct spell_data_expr_t;
 struct spell_data_t;
-struct work_queue_t;
 
 namespace report::json
 {
@@ -102,6 +107,8 @@ struct sim_t : private sc_thread_t
   player_t*   heal_target;
   vector_with_callback<player_t*> target_list;
   vector_with_callback<player_t*> target_non_sleeping_list;
+  // Bumped when target_non_sleeping_list or enemy positions change, stales every action target cache
+  uint64_t    target_cache_epoch;
   vector_with_callback<player_t*> player_list;
   vector_with_callback<player_t*> player_no_pet_list;
   vector_with_callback<player_t*> player_non_sleeping_list;
@@ -128,6 +135,22 @@ struct sim_t : private sc_thread_t
   timespan_t  ignite_sampling_delta;
   int         optimize_expressions;
   int         optimize_expressions_rounds;
+  int         compile_expressions;
+  // Reset only buffs and dots changed during the iteration, 2 verifies the untouched ones
+  int         reset_dirty_tracking;
+  // APL profiler, times every n'th evaluation of each line's expressions
+  int         apl_profile;
+  // Reuse APL line readiness while the sim state is unchanged, 2 validates the reused results
+  int         apl_ready_cache;
+  apl_versions_t apl_versions;
+  uint64_t    apl_ready_cache_lookups, apl_ready_cache_hits, apl_ready_cache_mismatches;
+  // Tree vs. bytecode expression evaluation benchmark, repetitions per evaluation
+  int         expression_benchmark;
+  uint64_t    expression_benchmark_evaluations, expression_benchmark_mismatches;
+  double      expression_benchmark_tree_time, expression_benchmark_program_time;
+  // Indexed vs. linear client data name lookup benchmark, and its results
+  bool        name_index_benchmark;
+  std::unique_ptr<dbc::name_index_benchmark_t> name_index_benchmark_data;
   int         current_slot;
   int         optimal_raid, log, debug_each;
   std::vector<uint64_t> debug_seed;
@@ -189,6 +212,7 @@ struct sim_t : private sc_thread_t
   int active_allies;
 
   std::vector<std::unique_ptr<option_t>> options;
+  opts::index_t option_index;
   std::vector<std::string> party_encoding;
   std::vector<std::string> item_db_sources;
 
@@ -197,6 +221,7 @@ struct sim_t : private sc_thread_t
   uint64_t seed;
   int deterministic;
   int strict_work_queue;
+  int chunked_work_queue;
   int average_range, average_gauss;
 
   // Raid Events
@@ -559,11 +584,15 @@ struct sim_t : private sc_thread_t
   chrono::cpu_clock::duration elapsed_cpu;
   chrono::wall_clock::duration elapsed_time;
   std::vector<size_t> work_per_thread;
+  std::vector<size_t> work_claims_per_thread, work_claimed_per_thread;
   size_t work_done;
+  work_chunk_t work_chunk;
   double     iteration_dmg, priority_iteration_dmg,  iteration_heal, iteration_absorb;
   simple_sample_data_t total_dmg, raid_hps, total_heal, total_absorb, raid_aps;
   extended_sample_data_t raid_dps, simulation_length;
   chrono::wall_clock::duration merge_time, init_time, analyze_time;
+  // Threads analyzing actor collected data (default 1, 0 uses threads), and the number used by the last analyze()
+  int analyze_threads, analyze_workers;
   // Deterministic simulation iteration data collectors for specific iteration
   // replayability
   std::vector<iteration_data_entry_t> iteration_data, low_iteration_data, high_iteration_data;
@@ -586,6 +615,7 @@ struct sim_t : private sc_thread_t
   std::vector<player_t*> targets_by_name;
   std::vector<std::string> id_dictionary;
   std::map<double, std::vector<double> > divisor_timeline_cache;
+  mutex_t divisor_timeline_mutex;
   std::vector<report::json::report_configuration_t> json_reports;
   std::string output_file_str, html_file_str, json_file_str;
   std::string reforge_plot_output_file_str;
@@ -601,6 +631,11 @@ struct sim_t : private sc_thread_t
   int save_raid_summary;
   int save_gear_comments;
   int statistics_level;
+  int streaming_statistics;
+  // Store report-only per-iteration samples as single precision floats
+  int compact_statistics;
+  int use_action_state_arena;
+  action_state_arena_t* action_state_arena;
   int separate_stats_by_actions;
   int report_raid_summary;
   int buff_uptime_timeline;
@@ -667,6 +702,7 @@ struct sim_t : private sc_thread_t
 
   bool display_hotfixes, disable_hotfixes;
   bool display_bonus_ids;
+  std::string client_data_output;
 
   // Profilesets
   opts::map_list_t profileset_map;
@@ -677,6 +713,9 @@ struct sim_t : private sc_thread_t
   std::vector<std::string> profileset_output_data;
   bool profileset_enabled;
   int profileset_work_threads, profileset_init_threads;
+  int profileset_warm_sims;
+  int profileset_race_top, profileset_race_iterations, profileset_race_rounds;
+  int profileset_processes;
   std::unique_ptr<profileset::profilesets_t> profilesets;
 
 
@@ -693,6 +732,7 @@ struct sim_t : private sc_thread_t
   void      cancel_iteration();
   void      cancel();
   void      interrupt();
+  int       work_queue_index() const;
   void      add_relative( sim_t* cousin );
   void      remove_relative( sim_t* cousin );
   sim_progress_t progress( std::string* detailed = nullptr, int index = -1 );
@@ -713,6 +753,7 @@ struct sim_t : private sc_thread_t
   void      merge();
   bool      iterate();
   void      partition();
+  void      init_children();
   bool      execute();
   void      analyze_error();
   void      analyze_iteration_data();
@@ -827,4 +868,5 @@ private:
   void enable_debug_seed();
   void disable_debug_seed();
   bool requires_cleanup() const;
+  void create_children();
 };
@@ -5,12 +5,28 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <vector>
 #include <mutex>
 #include "util/generic.hpp"
 
 struct sim_progress_t;
 
+// Thread-local state of a chunked work queue. A thread claims a range of iteration ordinals of a
+// (single actor batch) index at once, and only touches the shared queue state again when the range
+// is exhausted.
+struct work_chunk_t
+{
+  // Only written by the owning thread, atomic as the parent sim reads it during error analysis
+  std::atomic<size_t> index { 0 };
+  int next       = 0; // Ordinal of the next iteration to run
+  int end        = 0; // One past the last claimed ordinal
+  int done       = 0; // Completed iterations not yet published to the queue
+  size_t claims  = 0; // Number of chunks claimed by the thread
+  size_t claimed = 0; // Number of iterations claimed by the thread
+};
+
 struct work_queue_t
   {
     private:
@@ -28,29 +44,136 @@ struct work_queue_t
     no_m m;
     using G = nop;
 #endif
+    using counter_t = std::vector<std::atomic<int>>;
+
+    // Largest chunk claimed at once, bounds the lag of the published work counts
+    static constexpr int MAX_CHUNK = 64;
+
+    // Chunked (lock-free iteration) mode state
+    bool _chunked;
+    int _threads;
+    counter_t _claimed;
+    std::vector<std::atomic<bool>> _flushed;
+
+    static void resize( counter_t& c, size_t n )
+    {
+      counter_t r( n );
+      for ( size_t i = 0; i < std::min( n, c.size() ); ++i )
+        r[ i ] = c[ i ].load();
+      c.swap( r );
+    }
+
+    static void fill( counter_t& c, int v )
+    {
+      for ( auto& e : c )
+        e = v;
+    }
+
+    static void raise( std::atomic<int>& c, int v )
+    {
+      int cur = c.load( std::memory_order_relaxed );
+      while ( cur < v && !c.compare_exchange_weak( cur, v, std::memory_order_relaxed ) )
+      {
+      }
+    }
+
+    // Aim for several chunks per thread of the remaining projected work, so threads finish an index
+    // close to each other, and claims become finer as target_error projections close in.
+    int chunk_size( size_t idx, int total ) const
+    {
+      int projected = std::min( _projected_work[ idx ].load( std::memory_order_relaxed ), total );
+      int remaining = projected - _claimed[ idx ].load( std::memory_order_relaxed );
+      return std::clamp( remaining / ( 4 * _threads ), 1, MAX_CHUNK );
+    }
+
+    void publish( work_chunk_t& c )
+    {
+      if ( c.done == 0 )
+        return;
+
+      size_t idx = c.index.load( std::memory_order_relaxed );
+      int work = _work[ idx ].fetch_add( c.done, std::memory_order_relaxed ) + c.done;
+      c.done = 0;
+
+      if ( _flushed[ idx ].load( std::memory_order_relaxed ) )
+      {
+        raise( _total_work[ idx ], work );
+        raise( _projected_work[ idx ], work );
+      }
+      else if ( work >= _total_work[ idx ].load( std::memory_order_relaxed ) )
+      {
+        _projected_work[ idx ].store( work, std::memory_order_relaxed );
+      }
+    }
+
+    void claim( work_chunk_t& c )
+    {
+      while ( true )
+      {
+        size_t idx = c.index.load( std::memory_order_relaxed );
+        int total = _total_work[ idx ].load( std::memory_order_relaxed );
+        if ( !_flushed[ idx ].load( std::memory_order_relaxed ) )
+        {
+          int size  = chunk_size( idx, total );
+          int begin = _claimed[ idx ].fetch_add( size, std::memory_order_relaxed );
+          if ( begin < total )
+          {
+            c.next = begin;
+            c.end  = std::min( begin + size, total );
+            c.claims++;
+            c.claimed += c.end - c.next;
+            return;
+          }
+        }
+
+        c.next = c.end = 0;
+        if ( idx + 1 >= _total_work.size() )
+          return;
+
+        // Index exhausted, move on to the next actor. The shared index tracks the furthest index
+        // any thread has reached.
+        c.index.store( ++idx, std::memory_order_relaxed );
+        size_t cur = index.load( std::memory_order_relaxed );
+        while ( cur < idx && !index.compare_exchange_weak( cur, idx, std::memory_order_relaxed ) )
+        {
+        }
+      }
+    }
+
     public:
-    std::vector<int> _total_work, _work, _projected_work;
-    size_t index;
+    counter_t _total_work, _work, _projected_work;
+    std::atomic<size_t> index;
 
-    work_queue_t() : index( 0 )
-    { _total_work.resize( 1 ); _work.resize( 1 ); _projected_work.resize( 1 ); }
+    work_queue_t() : _chunked( false ), _threads( 1 ), _claimed( 1 ), _flushed( 1 ),
+      _total_work( 1 ), _work( 1 ), _projected_work( 1 ), index( 0 )
+    { }
 
-    void init( int w )    { G l(m); range::fill( _total_work, w ); range::fill( _projected_work, w ); }
+    void init( int w )    { G l(m); fill( _total_work, w ); fill( _projected_work, w ); }
     // Single actor batch sim init methods. Batches is the number of active actors
-    void batches( size_t n ) { G l(m); _total_work.resize( n ); _work.resize( n ); _projected_work.resize( n ); }
+    void batches( size_t n ) { G l(m); resize( _total_work, n ); resize( _work, n ); resize( _projected_work, n );
+                               resize( _claimed, n ); _flushed = std::vector<std::atomic<bool>>( n ); }
+    // Switch to chunked, lock-free claiming of iterations by threads sharing this queue
+    void chunked( int threads ) { G l(m); _chunked = true; _threads = std::max( 1, threads ); }
+    bool is_chunked() const { return _chunked; }
 
-    void flush()          { G l(m); _total_work[ index ] = _projected_work[ index ] = _work[ index ]; }
+    // Index being operated on by flush, project and progress. Chunked queue threads each run their own
+    // index, so callers pass the index of their claimed chunk, -1 is the shared index.
+    size_t resolve( int idx ) const { return idx < 0 ? index.load() : static_cast<size_t>( idx ); }
+
+    void flush( int idx = -1 ) { G l(m); size_t i = resolve( idx ); if ( _chunked ) _flushed[ i ] = true;
+                                 _total_work[ i ] = _projected_work[ i ] = _work[ i ].load(); }
     int  size()           { G l(m); return index < _total_work.size() ? _total_work[ index ] : _total_work.back(); }
     bool more_work()      { G l(m); return index < _total_work.size() && _work[ index ] < _total_work[ index ]; }
     void lock()           { m.lock(); }
     void unlock()         { m.unlock(); }
 
-    void project( int w )
+    void project( int w, int idx = -1 )
     {
       G l(m);
-      _projected_work[ index ] = w;
+      size_t i = resolve( idx );
+      _projected_work[ i ] = w;
 #ifdef NDEBUG
-      if ( w > _work[ index ] )
+      if ( w > _work[ i ] )
       {
       }
 #endif
@@ -73,7 +196,7 @@ struct work_queue_t
 
       if ( ++_work[ index ] == _total_work[ index ] )
       {
-        _projected_work[ index ] = _work[ index ];
+        _projected_work[ index ] = _work[ index ].load();
         if ( index < _work.size() - 1 )
         {
           ++index;
@@ -84,5 +207,40 @@ struct work_queue_t
       return index;
     }
 
+    // Chunked pop, the completed iteration consumes an ordinal of the thread's chunk. The first
+    // iteration of a thread is run before anything is claimed, so it claims its chunk here. The
+    // shared state is only touched when the chunk runs out, or the index has been flushed.
+    size_t pop( work_chunk_t& c )
+    {
+      if ( !_chunked )
+        return pop();
+
+      if ( c.next >= c.end )
+        claim( c );
+
+      if ( c.next < c.end )
+      {
+        c.next++;
+        c.done++;
+      }
+
+      if ( c.next >= c.end || _flushed[ c.index.load( std::memory_order_relaxed ) ].load( std::memory_order_relaxed ) )
+      {
+        publish( c );
+        c.next = c.end;
+        claim( c );
+      }
+
+      return c.index.load( std::memory_order_relaxed );
+    }
+
+    bool more_work( const work_chunk_t& c )
+    {
+      if ( !_chunked )
+        return more_work();
+
+      return c.next < c.end;
+    }
+
     sim_progress_t progress( int idx = -1 );
-  };
\ No newline at end of file
+  };
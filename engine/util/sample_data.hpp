@@ -6,19 +6,222 @@
 #ifndef SAMPLE_DATA_HPP
 #define SAMPLE_DATA_HPP
 
+#include <algorithm>
+#include <cmath>
+#include <deque>
 #include <limits>
 #include <numeric>
 #include <string>
 #include <vector>
 
+#include "config.hpp"
 #include "util/generic.hpp"
 #include "util/string_view.hpp"
 
+#if defined( __AVX__ )
+#define SC_STATISTICS_AVX
+#include <immintrin.h>
+#elif defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define SC_STATISTICS_SSE2
+#include <emmintrin.h>
+#endif
+
 /* Collection of statistical formulas for sequences
  * Note: Returns 0 for empty sequences
  */
 namespace statistics
 {
+/* Vectorized kernels over contiguous double sequences, used by the analysis of sample data and
+ * timelines. AVX or SSE2 is selected at compile time, with a scalar fallback. Results may differ
+ * from a sequential summation in the last bits.
+ */
+namespace kernel
+{
+inline double sum( const double* v, size_t n )
+{
+  size_t i = 0;
+  double result = 0;
+#if defined( SC_STATISTICS_AVX )
+  __m256d acc = _mm256_setzero_pd();
+  for ( ; i + 4 <= n; i += 4 )
+    acc = _mm256_add_pd( acc, _mm256_loadu_pd( v + i ) );
+  alignas( 32 ) double lanes[ 4 ];
+  _mm256_store_pd( lanes, acc );
+  result = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+#elif defined( SC_STATISTICS_SSE2 )
+  __m128d acc = _mm_setzero_pd();
+  for ( ; i + 2 <= n; i += 2 )
+    acc = _mm_add_pd( acc, _mm_loadu_pd( v + i ) );
+  alignas( 16 ) double lanes[ 2 ];
+  _mm_store_pd( lanes, acc );
+  result = lanes[ 0 ] + lanes[ 1 ];
+#endif
+  for ( ; i < n; ++i )
+    result += v[ i ];
+  return result;
+}
+
+// Sum of squared deviations from mean
+inline double squared_deviation( const double* v, size_t n, double mean )
+{
+  size_t i = 0;
+  double result = 0;
+#if defined( SC_STATISTICS_AVX )
+  __m256d acc = _mm256_setzero_pd(), m = _mm256_set1_pd( mean );
+  for ( ; i + 4 <= n; i += 4 )
+  {
+    __m256d d = _mm256_sub_pd( _mm256_loadu_pd( v + i ), m );
+    acc       = _mm256_add_pd( acc, _mm256_mul_pd( d, d ) );
+  }
+  alignas( 32 ) double lanes[ 4 ];
+  _mm256_store_pd( lanes, acc );
+  result = ( lanes[ 0 ] + lanes[ 1 ] ) + ( lanes[ 2 ] + lanes[ 3 ] );
+#elif defined( SC_STATISTICS_SSE2 )
+  __m128d acc = _mm_setzero_pd(), m = _mm_set1_pd( mean );
+  for ( ; i + 2 <= n; i += 2 )
+  {
+    __m128d d = _mm_sub_pd( _mm_loadu_pd( v + i ), m );
+    acc       = _mm_add_pd( acc, _mm_mul_pd( d, d ) );
+  }
+  alignas( 16 ) double lanes[ 2 ];
+  _mm_store_pd( lanes, acc );
+  result = lanes[ 0 ] + lanes[ 1 ];
+#endif
+  for ( ; i < n; ++i )
+    result += ( v[ i ] - mean ) * ( v[ i ] - mean );
+  return result;
+}
+
+// Minimum and maximum of a non-empty sequence
+inline void min_max( const double* v, size_t n, double& min, double& max )
+{
+  assert( n > 0 );
+  size_t i = 0;
+  min = max = v[ 0 ];
+#if defined( SC_STATISTICS_AVX )
+  if ( n >= 4 )
+  {
+    __m256d lo = _mm256_loadu_pd( v ), hi = lo;
+    for ( i = 4; i + 4 <= n; i += 4 )
+    {
+      __m256d x = _mm256_loadu_pd( v + i );
+      lo        = _mm256_min_pd( lo, x );
+      hi        = _mm256_max_pd( hi, x );
+    }
+    alignas( 32 ) double lo_lanes[ 4 ], hi_lanes[ 4 ];
+    _mm256_store_pd( lo_lanes, lo );
+    _mm256_store_pd( hi_lanes, hi );
+    min = std::min( std::min( lo_lanes[ 0 ], lo_lanes[ 1 ] ), std::min( lo_lanes[ 2 ], lo_lanes[ 3 ] ) );
+    max = std::max( std::max( hi_lanes[ 0 ], hi_lanes[ 1 ] ), std::max( hi_lanes[ 2 ], hi_lanes[ 3 ] ) );
+  }
+#elif defined( SC_STATISTICS_SSE2 )
+  if ( n >= 2 )
+  {
+    __m128d lo = _mm_loadu_pd( v ), hi = lo;
+    for ( i = 2; i + 2 <= n; i += 2 )
+    {
+      __m128d x = _mm_loadu_pd( v + i );
+      lo        = _mm_min_pd( lo, x );
+      hi        = _mm_max_pd( hi, x );
+    }
+    alignas( 16 ) double lo_lanes[ 2 ], hi_lanes[ 2 ];
+    _mm_store_pd( lo_lanes, lo );
+    _mm_store_pd( hi_lanes, hi );
+    min = std::min( lo_lanes[ 0 ], lo_lanes[ 1 ] );
+    max = std::max( hi_lanes[ 0 ], hi_lanes[ 1 ] );
+  }
+#endif
+  for ( ; i < n; ++i )
+  {
+    min = std::min( min, v[ i ] );
+    max = std::max( max, v[ i ] );
+  }
+}
+
+// Count values into num_buckets equal width buckets over [min, min + range], values equal to the
+// upper bound fall into the last bucket
+inline void histogram( const double* v, size_t n, double min, double range, size_t num_buckets, size_t* out )
+{
+  size_t i = 0;
+  auto count = [ out, num_buckets ]( int index ) {
+    size_t idx = static_cast<size_t>( index );
+    if ( idx == num_buckets )
+      --idx;
+    assert( idx < num_buckets );
+    out[ idx ]++;
+  };
+#if defined( SC_STATISTICS_AVX )
+  __m256d lo = _mm256_set1_pd( min ), r = _mm256_set1_pd( range ),
+          b = _mm256_set1_pd( static_cast<double>( num_buckets ) );
+  alignas( 16 ) int index[ 4 ];
+  for ( ; i + 4 <= n; i += 4 )
+  {
+    __m256d position = _mm256_div_pd( _mm256_sub_pd( _mm256_loadu_pd( v + i ), lo ), r );
+    _mm_store_si128( reinterpret_cast<__m128i*>( index ), _mm256_cvttpd_epi32( _mm256_mul_pd( b, position ) ) );
+    count( index[ 0 ] );
+    count( index[ 1 ] );
+    count( index[ 2 ] );
+    count( index[ 3 ] );
+  }
+#elif defined( SC_STATISTICS_SSE2 )
+  __m128d lo = _mm_set1_pd( min ), r = _mm_set1_pd( range ), b = _mm_set1_pd( static_cast<double>( num_buckets ) );
+  alignas( 16 ) int index[ 4 ];
+  for ( ; i + 2 <= n; i += 2 )
+  {
+    __m128d position = _mm_div_pd( _mm_sub_pd( _mm_loadu_pd( v + i ), lo ), r );
+    _mm_store_si128( reinterpret_cast<__m128i*>( index ), _mm_cvttpd_epi32( _mm_mul_pd( b, position ) ) );
+    count( index[ 0 ] );
+    count( index[ 1 ] );
+  }
+#endif
+  for ( ; i < n; ++i )
+    count( static_cast<int>( num_buckets * ( ( v[ i ] - min ) / range ) ) );
+}
+
+// dst[ i ] += src[ i ]
+inline void add( double* dst, const double* src, size_t n )
+{
+  size_t i = 0;
+#if defined( SC_STATISTICS_AVX )
+  for ( ; i + 4 <= n; i += 4 )
+    _mm256_storeu_pd( dst + i, _mm256_add_pd( _mm256_loadu_pd( dst + i ), _mm256_loadu_pd( src + i ) ) );
+#elif defined( SC_STATISTICS_SSE2 )
+  for ( ; i + 2 <= n; i += 2 )
+    _mm_storeu_pd( dst + i, _mm_add_pd( _mm_loadu_pd( dst + i ), _mm_loadu_pd( src + i ) ) );
+#endif
+  for ( ; i < n; ++i )
+    dst[ i ] += src[ i ];
+}
+
+// dst[ i ] /= divisor[ i ]
+inline void divide( double* dst, const double* divisor, size_t n )
+{
+  size_t i = 0;
+#if defined( SC_STATISTICS_AVX )
+  for ( ; i + 4 <= n; i += 4 )
+    _mm256_storeu_pd( dst + i, _mm256_div_pd( _mm256_loadu_pd( dst + i ), _mm256_loadu_pd( divisor + i ) ) );
+#elif defined( SC_STATISTICS_SSE2 )
+  for ( ; i + 2 <= n; i += 2 )
+    _mm_storeu_pd( dst + i, _mm_div_pd( _mm_loadu_pd( dst + i ), _mm_loadu_pd( divisor + i ) ) );
+#endif
+  for ( ; i < n; ++i )
+    dst[ i ] /= divisor[ i ];
+}
+}  // namespace kernel
+
+inline double calculate_sum( const std::vector<double>& r )
+{
+  return kernel::sum( r.data(), r.size() );
+}
+
+inline double calculate_variance( const std::vector<double>& r, double mean )
+{
+  auto tmp = kernel::squared_deviation( r.data(), r.size(), mean );
+  if ( r.size() > 1 )
+    tmp /= r.size();
+  return tmp;
+}
+
 /* Arithmetic Sum
  */
 template <typename Range>
@@ -154,6 +357,19 @@ std::vector<size_t> create_histogram( const Range& r, size_t num_buckets )
   return create_histogram( r, num_buckets, min, max );
 }
 
+inline std::vector<size_t> create_histogram( const std::vector<double>& r, size_t num_buckets, double min,
+                                             double max )
+{
+  std::vector<size_t> result;
+  if ( r.empty() || std::isnan( min ) || std::isnan( max ) || max <= min )
+    return result;
+
+  result.assign( num_buckets, size_t{} );
+  kernel::histogram( r.data(), r.size(), min, max - min, num_buckets, result.data() );
+
+  return result;
+}
+
 /* Normalizes a histogram.
  * sum over all elements of the histogram will be equal to 1.0
  */
@@ -304,9 +520,223 @@ public:
   }
 };
 
+/* Mergeable quantile sketch ( merging t-digest, Dunning & Ertl 2019 )
+ * Summarizes a sample distribution with a bounded number of weighted centroids, kept small near
+ * the tails of the distribution so extreme quantiles remain accurate. Sketches from different
+ * threads can be merged without loss of accuracy guarantees.
+ */
+class quantile_sketch_t
+{
+public:
+  using value_t = double;
+
+private:
+  struct centroid_t
+  {
+    value_t mean;
+    double weight;
+  };
+
+  double _compression;
+  std::vector<centroid_t> _centroids;
+  std::vector<centroid_t> _buffer;
+  double _weight = 0; // Total weight of the centroids
+  value_t _min   = std::numeric_limits<value_t>::max();
+  value_t _max   = std::numeric_limits<value_t>::lowest();
+
+  // k1 scale function, and its inverse
+  double scale( double q ) const
+  {
+    return _compression / ( 2 * m_pi ) * std::asin( 2 * q - 1 );
+  }
+
+  double scale_inverse( double k ) const
+  {
+    if ( k >= _compression / 4 )
+      return 1.0;
+
+    return ( std::sin( k * 2 * m_pi / _compression ) + 1 ) / 2;
+  }
+
+  // Cumulative weight at the center of each centroid
+  double center( size_t idx, double cumulative ) const
+  {
+    return cumulative + _centroids[ idx ].weight / 2;
+  }
+
+public:
+  explicit quantile_sketch_t( double compression = 200 ) : _compression( compression )
+  {
+  }
+
+  void add( value_t x )
+  {
+    _buffer.push_back( { x, 1.0 } );
+    _min = std::min( _min, x );
+    _max = std::max( _max, x );
+
+    if ( _buffer.size() >= static_cast<size_t>( 5 * _compression ) )
+      flush();
+  }
+
+  void merge( const quantile_sketch_t& other )
+  {
+    _buffer.insert( _buffer.end(), other._centroids.begin(), other._centroids.end() );
+    _buffer.insert( _buffer.end(), other._buffer.begin(), other._buffer.end() );
+    _min = std::min( _min, other._min );
+    _max = std::max( _max, other._max );
+
+    flush();
+  }
+
+  // Merge buffered samples into the centroids. Required before the sketch is queried.
+  void flush()
+  {
+    if ( _buffer.empty() )
+      return;
+
+    _buffer.insert( _buffer.end(), _centroids.begin(), _centroids.end() );
+    std::sort( _buffer.begin(), _buffer.end(),
+               []( const centroid_t& l, const centroid_t& r ) { return l.mean < r.mean; } );
+
+    double total = 0;
+    for ( const auto& c : _buffer )
+      total += c.weight;
+
+    _centroids.clear();
+
+    auto current      = _buffer.front();
+    double cumulative = 0;
+    double limit      = total * scale_inverse( scale( 0 ) + 1 );
+    for ( size_t i = 1; i < _buffer.size(); ++i )
+    {
+      const auto& next = _buffer[ i ];
+      if ( cumulative + current.weight + next.weight <= limit )
+      {
+        current.weight += next.weight;
+        current.mean += ( next.mean - current.mean ) * next.weight / current.weight;
+      }
+      else
+      {
+        cumulative += current.weight;
+        _centroids.push_back( current );
+        limit   = total * scale_inverse( scale( cumulative / total ) + 1 );
+        current = next;
+      }
+    }
+    _centroids.push_back( current );
+
+    _weight = total;
+    _buffer.clear();
+  }
+
+  // Approximate quantile of the sketched distribution, requires a flushed sketch
+  value_t quantile( double q ) const
+  {
+    assert( _buffer.empty() );
+
+    if ( _centroids.empty() )
+      return 0;
+
+    if ( _centroids.size() == 1 )
+      return _centroids.front().mean;
+
+    double index = q * _weight;
+    if ( index <= _centroids.front().weight / 2 )
+      return _min + ( _centroids.front().mean - _min ) * index / ( _centroids.front().weight / 2 );
+
+    double cumulative = 0;
+    for ( size_t i = 0; i + 1 < _centroids.size(); ++i )
+    {
+      double left  = center( i, cumulative );
+      double right = center( i + 1, cumulative + _centroids[ i ].weight );
+      if ( index < right )
+      {
+        double t = ( index - left ) / ( right - left );
+        return _centroids[ i ].mean + t * ( _centroids[ i + 1 ].mean - _centroids[ i ].mean );
+      }
+      cumulative += _centroids[ i ].weight;
+    }
+
+    const auto& last = _centroids.back();
+    double t         = ( index - center( _centroids.size() - 1, cumulative ) ) / ( last.weight / 2 );
+    return last.mean + std::min( t, 1.0 ) * ( _max - last.mean );
+  }
+
+  // Approximate fraction of the samples below x, requires a flushed sketch
+  double cdf( value_t x ) const
+  {
+    assert( _buffer.empty() );
+
+    if ( _centroids.empty() || x < _min )
+      return 0;
+
+    if ( x >= _max )
+      return 1;
+
+    const auto& first = _centroids.front();
+    if ( x < first.mean )
+      return first.mean > _min ? ( x - _min ) / ( first.mean - _min ) * first.weight / 2 / _weight : 0;
+
+    double cumulative = 0;
+    for ( size_t i = 0; i + 1 < _centroids.size(); ++i )
+    {
+      const auto& next = _centroids[ i + 1 ];
+      if ( x < next.mean )
+      {
+        double left  = center( i, cumulative );
+        double right = center( i + 1, cumulative + _centroids[ i ].weight );
+        double t     = ( x - _centroids[ i ].mean ) / ( next.mean - _centroids[ i ].mean );
+        return ( left + t * ( right - left ) ) / _weight;
+      }
+      cumulative += _centroids[ i ].weight;
+    }
+
+    const auto& last = _centroids.back();
+    double t         = _max > last.mean ? ( x - last.mean ) / ( _max - last.mean ) : 1;
+    return ( center( _centroids.size() - 1, cumulative ) + t * last.weight / 2 ) / _weight;
+  }
+
+  // Bound of the rank error of quantile( q ) as a fraction of the sample count, half the weight of
+  // the centroid the quantile falls into
+  double rank_error( double q ) const
+  {
+    assert( _buffer.empty() );
+
+    double index = q * _weight, cumulative = 0;
+    for ( const auto& c : _centroids )
+    {
+      cumulative += c.weight;
+      if ( index <= cumulative )
+        return c.weight > 1 ? c.weight / 2 / _weight : 0;
+    }
+
+    return 0;
+  }
+
+  size_t size() const
+  {
+    return _centroids.size() + _buffer.size();
+  }
+
+  void clear()
+  {
+    _centroids.clear();
+    _buffer.clear();
+    _weight = 0;
+    _min    = std::numeric_limits<value_t>::max();
+    _max    = std::numeric_limits<value_t>::lowest();
+  }
+};
+
 /* Extensive sample_data container with two runtime dependent modes:
  * - simple: Only offers sum, count
  *  -!simple: saves data and offers variance, percentiles, distribution, etc.
+ * A !simple container can be switched to streaming, where no data is saved. Variance is computed
+ * online ( Welford ), and percentiles and the distribution are approximated from a quantile sketch.
+ * A !simple container can alternatively be switched to compact, where samples are saved as single
+ * precision floats in chunked storage and sorted in place. Sum, min and max remain exact, other
+ * statistics carry a relative error of at most 2^-24. The unsorted sample order is not kept.
  */
 class extended_sample_data_t : public simple_sample_data_with_min_max_t
 {
@@ -318,8 +748,17 @@ public:
   value_t _mean, variance, std_dev, mean_variance, mean_std_dev;
   std::vector<size_t> distribution;
   bool simple;
+  bool streaming;
+  bool compact;
 
 private:
+  // Streaming mode state
+  value_t _welford_mean, _welford_m2;
+  quantile_sketch_t _sketch;
+
+  // Compact mode samples
+  std::deque<float> _compact_data;
+
   std::vector<value_t> _data;
   std::vector<value_t> _sorted_data;  // extra sequence so we can keep the
                                       // original, unsorted order ( for example
@@ -336,6 +775,10 @@ public:
       mean_variance(),
       mean_std_dev(),
       simple( s ),
+      streaming( false ),
+      compact( false ),
+      _welford_mean(),
+      _welford_m2(),
       is_sorted( false )
   {
   }
@@ -347,6 +790,23 @@ public:
     clear();
   }
 
+  // Switch a !simple container between exact and streaming statistics
+  void change_streaming( bool s )
+  {
+    streaming = s && !simple;
+    compact   = compact && !streaming;
+
+    clear();
+  }
+
+  // Switch a !simple, non-streaming container between exact and compact sample storage
+  void change_compact( bool c )
+  {
+    compact = c && !simple && !streaming;
+
+    clear();
+  }
+
   const std::string& name() const
   {
     return name_str;
@@ -355,7 +815,7 @@ public:
   // Reserve memory
   void reserve( std::size_t capacity )
   {
-    if ( !simple )
+    if ( !simple && !streaming && !compact )
       _data.reserve( capacity );
   }
 
@@ -366,6 +826,23 @@ public:
     {
       base_t::add( x );
     }
+    else if ( streaming )
+    {
+      base_t::add( x );
+
+      double delta = x - _welford_mean;
+      _welford_mean += delta / base_t::count();
+      _welford_m2 += delta * ( x - _welford_mean );
+
+      _sketch.add( x );
+      is_sorted = false;
+    }
+    else if ( compact )
+    {
+      base_t::add( x );
+      _compact_data.push_back( static_cast<float>( x ) );
+      is_sorted = false;
+    }
     else
     {
       _data.push_back( x );
@@ -380,7 +857,7 @@ public:
 
   size_t size() const
   {
-    if ( simple )
+    if ( simple || streaming || compact )
       return base_t::count();
 
     return _data.size();
@@ -405,6 +882,20 @@ public:
     if ( simple )
       return;
 
+    if ( streaming )
+    {
+      // Sum, min and max are tracked on add
+      _mean = base_t::count() ? _welford_mean : 0;
+      return;
+    }
+
+    if ( compact )
+    {
+      // Sum, min and max are tracked on add
+      _mean = base_t::count() ? base_t::_sum / base_t::count() : 0;
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -415,9 +906,10 @@ public:
     }
     else
     {
-      auto minmax = std::minmax_element( data().begin(), data().end() );
-      base_t::set_min( *minmax.first );
-      base_t::set_max( *minmax.second );
+      double min, max;
+      statistics::kernel::min_max( data().data(), data().size(), min, max );
+      base_t::set_min( min );
+      base_t::set_max( max );
     }
 
     base_t::_sum = statistics::calculate_sum( data() );
@@ -434,7 +926,7 @@ public:
   }
   size_t count() const
   {
-    return simple ? base_t::count() : data().size();
+    return simple || streaming || compact ? base_t::count() : data().size();
   }
 
   /* Analyze Variance: Variance, Stddev and Stddev of the mean
@@ -445,16 +937,26 @@ public:
     if ( simple )
       return;
 
-    if ( _data.empty() )
+    if ( count() == 0 )
       return;
 
-    variance = statistics::calculate_variance( data(), mean() );
+    if ( streaming )
+      variance = _welford_m2 / count();
+    else if ( compact )
+    {
+      variance = 0;
+      for ( double value : _compact_data )
+        variance += ( value - mean() ) * ( value - mean() );
+      variance /= count();
+    }
+    else
+      variance = statistics::calculate_variance( data(), mean() );
     std_dev  = std::sqrt( variance );
 
     // Calculate Standard Deviation of the Mean ( Central Limit Theorem )
-    if ( data().size() > 1 )
+    if ( count() > 1 )
     {
-      mean_variance = variance / data().size();
+      mean_variance = variance / count();
       mean_std_dev  = std::sqrt( mean_variance );
     }
   }
@@ -471,6 +973,18 @@ public:
     {
       return;
     }
+    if ( streaming )
+    {
+      _sketch.flush();
+      is_sorted = true;
+      return;
+    }
+    if ( compact )
+    {
+      range::sort( _compact_data );
+      is_sorted = true;
+      return;
+    }
     _sorted_data = _data;
     range::sort( _sorted_data );
     is_sorted = true;
@@ -485,6 +999,21 @@ public:
     if ( simple )
       return;
 
+    if ( streaming )
+    {
+      create_sketch_histogram( num_buckets );
+      return;
+    }
+
+    if ( compact )
+    {
+      if ( !_compact_data.empty() )
+        distribution = statistics::create_histogram( _compact_data, num_buckets,
+                                                     static_cast<float>( base_t::min() ),
+                                                     static_cast<float>( base_t::max() ) );
+      return;
+    }
+
     if ( data().empty() )
       return;
 
@@ -498,6 +1027,9 @@ public:
     _sorted_data.clear();
     _data.clear();
     distribution.clear();
+    _welford_mean = _welford_m2 = 0;
+    _sketch.clear();
+    _compact_data.clear();
   }
 
   // Access functions
@@ -510,16 +1042,31 @@ public:
     if ( simple )
       return 0;
 
-    if ( data().empty() )
+    if ( count() == 0 )
       return 0;
 
     if ( !is_sorted )
       return base_t::nan();
 
+    if ( streaming )
+      return _sketch.quantile( x );
+
+    if ( compact )
+      return _compact_data[ static_cast<size_t>( x * ( _compact_data.size() - 1 ) ) ];
+
     // Should be improved to use linear interpolation
     return ( sorted_data()[ (int)( x * ( sorted_data().size() - 1 ) ) ] );
   }
 
+  // Bound of the rank error of percentile( x ) as a fraction of the count, 0 for exact data
+  value_t percentile_error( double x ) const
+  {
+    if ( !streaming || !is_sorted )
+      return 0;
+
+    return _sketch.rank_error( x );
+  }
+
   const std::vector<value_t>& data() const
   {
     return _data;
@@ -537,10 +1084,66 @@ public:
     {
       base_t::merge( other );
     }
+    else if ( streaming )
+    {
+      // Chan et al. parallel variance combination
+      double n1 = as<double>( base_t::count() ), n2 = as<double>( other.base_t::count() );
+      if ( n2 > 0 )
+      {
+        double delta = other._welford_mean - _welford_mean;
+        _welford_mean += delta * n2 / ( n1 + n2 );
+        _welford_m2 += other._welford_m2 + delta * delta * n1 * n2 / ( n1 + n2 );
+      }
+
+      base_t::merge( other );
+      _sketch.merge( other._sketch );
+      is_sorted = false;
+    }
+    else if ( compact )
+    {
+      base_t::merge( other );
+      _compact_data.insert( _compact_data.end(), other._compact_data.begin(), other._compact_data.end() );
+      is_sorted = false;
+    }
     else
       _data.insert( _data.end(), other._data.begin(), other._data.end() );
   }
 
+  // Approximate heap memory held by the collected samples, in bytes
+  size_t memory_usage() const
+  {
+    return ( _data.capacity() + _sorted_data.capacity() ) * sizeof( value_t ) +
+           _compact_data.size() * sizeof( float ) + _sketch.size() * 2 * sizeof( double ) +
+           distribution.capacity() * sizeof( size_t );
+  }
+
+private:
+  // Histogram of the streaming distribution, bucket counts are derived from the rounded sample
+  // counts below each bucket boundary so that they sum up to the sample count
+  void create_sketch_histogram( unsigned int num_buckets )
+  {
+    if ( count() == 0 || base_t::max() <= base_t::min() )
+      return;
+
+    _sketch.flush();
+
+    double n      = as<double>( count() );
+    double width  = ( base_t::max() - base_t::min() ) / num_buckets;
+    size_t below  = 0;
+
+    distribution.assign( num_buckets, size_t{} );
+    for ( unsigned int i = 0; i < num_buckets; ++i )
+    {
+      size_t upto = i + 1 == num_buckets
+                        ? count()
+                        : static_cast<size_t>( std::round( _sketch.cdf( base_t::min() + ( i + 1 ) * width ) * n ) );
+      upto = std::max( below, std::min( upto, count() ) );
+
+      distribution[ i ] = upto - below;
+      below             = upto;
+    }
+  }
+
 };  // sample_data_t
 
 #endif  // SAMPLE_DATA_HPP
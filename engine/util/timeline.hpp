@@ -10,6 +10,7 @@
 #include <cassert>
 #include <cstring>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 #include "util/generic.hpp"
@@ -115,9 +116,17 @@ public:
   void adjust( const std::vector<A>& divisor_timeline )
   {
 
-    for ( size_t j = 0, size = std::min( data().size(), divisor_timeline.size() ); j < size; j++ )
+    size_t size = std::min( data().size(), divisor_timeline.size() );
+    if constexpr ( std::is_same_v<A, double> )
     {
-      _data[ j ] /= divisor_timeline[ j ];
+      statistics::kernel::divide( _data.data(), divisor_timeline.data(), size );
+    }
+    else
+    {
+      for ( size_t j = 0; j < size; j++ )
+      {
+        _data[ j ] /= divisor_timeline[ j ];
+      }
     }
   }
 
@@ -141,8 +150,7 @@ public:
   void merge( const timeline_t& other )
   {
     // merge shared range
-    for ( size_t j = 0, num_buckets = std::min( _data.size(), other.data().size() ); j < num_buckets; ++j )
-      _data[ j ] += other.data()[ j ];
+    statistics::kernel::add( _data.data(), other.data().data(), std::min( _data.size(), other.data().size() ) );
 
     // if other is larger, insert tail
     if ( _data.size() < other.data().size() )
@@ -244,6 +244,11 @@ std::string util::build_info_str( const dbc_t* dbc, int display_level )
         fmt::format( "hotfix {}/{}", dbc::hotfix_date_str( dbc->ptr ), dbc::hotfix_build_version( dbc->ptr ) ) );
   }
 
+  if ( auto client_data = dbc::mapped_client_data_str( dbc->ptr ); !client_data.empty() )
+  {
+    build_strings.emplace_back( fmt::format( "client data {}", client_data ) );
+  }
+
   if ( git_info::available() && display_level != 2 )
   {
     build_strings.emplace_back( fmt::format( "git build {} {}", git_info::branch(), git_info::revision() ) );
@@ -57,6 +57,16 @@ CONFIG(openssl) {
   message(Building without networking support)
 }
 
+!isEmpty(SC_NO_CLIENT_DATA_BLOB) {
+  DEFINES += SC_NO_CLIENT_DATA_BLOB
+  message(Building without external client data support)
+}
+
+!isEmpty(SC_EXTERNAL_ITEM_DATA_ONLY) {
+  DEFINES += SC_EXTERNAL_ITEM_DATA_ONLY
+  message(Building with item bonus and item effect data loaded only from the external client data file)
+}
+
 contains(QMAKE_CXX, .+/clang\+\+)|contains(QMAKE_CXX, .+/g\+\+) {
   QMAKE_CXXFLAGS += -Wextra
   QMAKE_CXXFLAGS_RELEASE -= -O2
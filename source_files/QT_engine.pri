@@ -151,6 +151,7 @@ HEADERS += engine/report/report_helper.hpp
 HEADERS += engine/report/report_timer.hpp
 HEADERS += engine/report/reports.hpp
 HEADERS += engine/sc_enums.hpp
+HEADERS += engine/sim/apl_versions.hpp
 HEADERS += engine/sim/benefit.hpp
 HEADERS += engine/sim/cooldown.hpp
 HEADERS += engine/sim/cooldown_waste_data.hpp
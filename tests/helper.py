@@ -1,4 +1,4 @@
-import sys, os, shutil, subprocess, re, signal
+import sys, os, shutil, subprocess, re, signal, json, tempfile
 from pathlib import Path
 
 def __error_status(code):
@@ -81,8 +81,66 @@ class Test(object):
                 args.append(str(arg))
         return args
 
+# Runs the test with an option off and on, both with a fixed seed, and requires identical results
+class EquivalenceTest(Test):
+    def __init__(self, name, **kwargs):
+        super().__init__(name, **kwargs)
+        self.option = kwargs.get('option', name)
+        self.values = kwargs.get('values', ( '0', '1' ))
+
+    def variant_args(self, value, json_path):
+        args = self.args()
+        args.extend([
+            'deterministic=1',
+            'seed=1',
+            '{}={}'.format(self.option, value),
+            'json={}'.format(json_path),
+        ])
+        return args
+
+class ResultMismatch(Exception):
+    def __init__(self, cmd, message):
+        super().__init__(message)
+        self.cmd = cmd
+
+def __results(json_path):
+    with open(json_path, encoding='UTF-8') as f:
+        data = json.load(f)
+    sim = data['sim']
+    results = { 'fight_length': sim['statistics']['simulation_length']['mean'] }
+    for player in sim['players']:
+        results[player['name']] = player['collected_data'].get('dps', {}).get('mean', 0)
+    return results
+
+def run_equivalence_test(test):
+    results = []
+    wall_time = 0
+    stderr = ''
+    with tempfile.TemporaryDirectory() as tmp:
+        for value in test.values:
+            args = [ SIMC_CLI_PATH ]
+            args.extend(test.variant_args(value, os.path.join(tmp, '{}.json'.format(value))))
+            try:
+                res = subprocess.run(args, check=True, stdout=subprocess.PIPE, stderr=subprocess.PIPE, encoding='UTF-8', timeout=30)
+            except subprocess.CalledProcessError as err:
+                return ( False, 0, err, err.stderr )
+            wall_time += float(SIMC_WALL_SECONDS_RE.search(res.stdout).group(1))
+            stderr += res.stderr
+            results.append(( value, __results(os.path.join(tmp, '{}.json'.format(value))) ))
+
+    base_value, base = results[0]
+    for value, other in results[1:]:
+        if other != base:
+            diff = [ '{}: {} vs {}'.format(k, base.get(k), other.get(k)) for k in sorted(set(base) | set(other)) if base.get(k) != other.get(k) ]
+            err = ResultMismatch(' '.join(args), '{}={} and {}={} differ: {}'.format(test.option, base_value, test.option, value, ', '.join(diff)))
+            return ( False, 0, err, stderr )
+    return ( True, wall_time, None, stderr )
+
 SIMC_WALL_SECONDS_RE = re.compile('WallSeconds\\s*=\\s*([0-9\\.]+)')
 def run_test(test):
+    if isinstance(test, EquivalenceTest):
+        return run_equivalence_test(test)
+
     args = [ SIMC_CLI_PATH ]
     args.extend(test.args())
 
@@ -110,7 +168,8 @@ def run(tests):
             success += 1
         else:
             print('[FAIL]')
-            print('-- {:<62} --------------'.format(__error_status(err.returncode)))
+            status = str(err) if isinstance(err, ResultMismatch) else __error_status(err.returncode)
+            print('-- {:<62} --------------'.format(status))
             print(err.cmd)
             if stderr:
                 print(stderr.rstrip('\r\n'))
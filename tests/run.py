@@ -13,7 +13,7 @@ except ImportError:
         "simc-support dependency missing. Please install using 'pip3 install -r requirements.txt'"
     )
 
-from helper import Test, TestGroup, run, find_profiles
+from helper import Test, EquivalenceTest, TestGroup, run, find_profiles
 
 FIGHT_STYLES = ("Patchwerk", "DungeonSlice", "HeavyMovement",)
 SEASON = Season.Season.SEASON_2
@@ -72,9 +72,52 @@ def test_baseline(klass: str, path: str, enable: dict):
         ],
     )
 
+# Test that performance options leave results unchanged
+def test_equivalence(klass: str, path: str, enable: dict):
+    fight_style = "Patchwerk"
+    grp = TestGroup(
+        "{}/{}/equivalence".format(profile, fight_style),
+        fight_style=fight_style,
+        profile=path,
+        threads=1,
+    )
+    tests.append(grp)
+    EquivalenceTest(
+        "apl ready cache",
+        group=grp,
+        option="apl_ready_cache",
+    )
+    EquivalenceTest(
+        "action state arena",
+        group=grp,
+        option="action_state_arena",
+    )
+    EquivalenceTest(
+        "compile expressions",
+        group=grp,
+        option="compile_expressions",
+    )
+    EquivalenceTest(
+        "stat cache",
+        group=grp,
+        option="stat_cache",
+    )
+    EquivalenceTest(
+        "reset dirty tracking",
+        group=grp,
+        option="reset_dirty_tracking",
+    )
+    EquivalenceTest(
+        "analyze threads",
+        group=grp,
+        option="analyze_threads",
+        values=( "1", "2" ),
+    )
+
 available_tests = {
     "trinket": test_trinkets,
     "baseline": test_baseline,
+    "equivalence": test_equivalence,
 }
 
 parser = argparse.ArgumentParser(description="Run simc tests.")